@@ -12,6 +12,6 @@ glabel gMapStringsEnd
 
 .balign 16
 glabel gMapEntrySize
-.word (gMapEntryEnd - gMapEntries) / 4
+.word (gMapEntryEnd - gMapEntries) / 8
 glabel gMapStringSize
 .word (gMapStringsEnd - gMapStrings)
@@ -0,0 +1,17 @@
+# The method to compress $(BUILD_DIR)/$(1).bin with
+segment-compress = $(or $(SEGMENT_COMPRESS_$(1)),$(COMPRESS))
+
+# Compress binary file, using compress-<method> from the method's rules file
+$(BUILD_DIR)/%.szp: $(BUILD_DIR)/%.bin compression/segment_compression.mk
+	$(call print,Compressing ($(call segment-compress,$*)):,$<,$@)
+	$(compress-$(call segment-compress,$*))
+
+# convert binary szp to object file
+$(BUILD_DIR)/%.szp.o: $(BUILD_DIR)/%.szp
+	$(call print,Converting to ELF:,$<,$@)
+	$(V)$(LD) -r -b binary $< -o $@
+
+# Size, ratio and estimated decode time of every compressed segment
+$(COMPRESSION_REPORT): $(ELF) $(COMPRESSION_REPORT_PY)
+	$(call print,Writing compression report:,$(BUILD_DIR),$@)
+	$(V)$(PYTHON) $(COMPRESSION_REPORT_PY) $(BUILD_DIR) > $@
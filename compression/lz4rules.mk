@@ -0,0 +1,4 @@
+# Compress binary file
+define compress-lz4
+$(V)$(LZ4PACK) $< $@
+endef
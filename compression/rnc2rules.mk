@@ -1,9 +1,4 @@
 # Compress binary file
-$(BUILD_DIR)/%.szp: $(BUILD_DIR)/%.bin
-	$(call print,Compressing:,$<,$@)
-	$(V)$(RNCPACK) p $< $@ -m2
-
-# convert binary szp to object file
-$(BUILD_DIR)/%.szp.o: $(BUILD_DIR)/%.szp
-	$(call print,Converting RNC2 to ELF:,$<,$@)
-	$(V)$(LD) -r -b binary $< -o $@
\ No newline at end of file
+define compress-rnc2
+$(V)$(RNCPACK) p $< $@ -m2
+endef
@@ -0,0 +1,17 @@
+# Per-segment compression
+#
+# Every compressed segment uses COMPRESS, unless it's listed here with the method it should use instead:
+#   SEGMENT_COMPRESS_<segment> := <method>
+# <segment> is the segment's .bin file in the build directory, without the extension,
+# e.g. bin/segment2, bin/water, actors/group0 or levels/bob/leveldata.
+# <method> is one of mio0, yay0, gzip, rnc1, rnc2 or lz4. The decoders for every method in use are built in.
+#
+# Check $(BUILD_DIR)/compression_report.txt after a build for how large each segment is, and how long it
+# should take to decompress, to decide which ones are worth changing.
+#
+# This is ignored when building with COMPRESS=uncomp.
+#
+# For example, to make large texture banks smaller and Mario's actor group faster to load:
+# SEGMENT_COMPRESS_bin/water    := gzip
+# SEGMENT_COMPRESS_bin/mountain := gzip
+# SEGMENT_COMPRESS_actors/group0 := lz4
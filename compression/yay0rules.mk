@@ -1,9 +1,4 @@
 # Compress binary file
-$(BUILD_DIR)/%.szp: $(BUILD_DIR)/%.bin
-	$(call print,Compressing:,$<,$@)
-	$(V)$(YAY0TOOL) $< $@
-
-# convert binary szp to object file
-$(BUILD_DIR)/%.szp.o: $(BUILD_DIR)/%.szp
-	$(call print,Converting YAY0 to ELF:,$<,$@)
-	$(V)$(LD) -r -b binary $< -o $@
\ No newline at end of file
+define compress-yay0
+$(V)$(YAY0TOOL) $< $@
+endef
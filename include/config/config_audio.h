@@ -45,6 +45,20 @@
 #define MAX_SIMULTANEOUS_NOTES_EMULATOR 40
 #define MAX_SIMULTANEOUS_NOTES_CONSOLE 24
 
+/**
+ * Skips synthesizing notes that are effectively silent, like notes on muted channels or at the very end of their release.
+ * These keep playing on the CPU without making any audio commands, and are synthesized again as soon as they're audible.
+ * This lowers RSP time and the size of the audio command list in busy scenes, without changing what's heard.
+ */
+// #define VIRTUAL_VOICES
+
+/**
+ * When every note is in use, steal the quietest note of the lowest priority instead of just any note of the lowest priority.
+ * Notes that are nearly silent, such as far away sounds or faded out channels, can then be stolen by a note of any priority,
+ * while notes that have only just started are kept. Steals and dropped notes are shown on the audio page of Puppyprint Debug.
+ */
+// #define AUDIBILITY_NOTE_STEALING
+
 /** 
  * Uses a much better implementation of reverb over vanilla's fake echo reverb. Great for caves or eerie levels, as well as just a better audio experience in general.
  * Reverb presets can be configured in audio/data.c to meet desired aesthetic/performance needs. More detailed usage info can also be found on the HackerSM64 Wiki page.
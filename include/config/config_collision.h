@@ -34,3 +34,34 @@
  */
 #define COLLISION_DATA_TYPE s16
 #define ROOM_DATA_TYPE s8
+
+/**
+ * Copies the level's static surfaces into flat per-cell arrays once the area has loaded, instead of keeping them
+ * in linked lists of surface nodes. Collision queries then walk contiguous memory rather than chasing node pointers.
+ * Costs an extra copy of each surface for every cell it occupies (0x34 bytes per entry instead of 0x8),
+ * plus an index the same size as the static partition itself, so levels with many large triangles use noticeably more RAM.
+ */
+// #define FLAT_STATIC_PARTITION
+
+/**
+ * Splits each cell of the flattened static partition into buckets of this many units along Y, so that floor, ceiling
+ * and wall checks only visit the surfaces around the height being checked. Helps levels with many surfaces stacked
+ * over each other, like towers. Costs 2 bytes for every bucket a surface overlaps. Enables FLAT_STATIC_PARTITION.
+ */
+// #define STATIC_PARTITION_Y_BUCKET_SIZE 512
+
+/**
+ * Keeps each object's surfaces in the dynamic partition between frames, and only reloads them when the object
+ * moves, rotates or scales, instead of rebuilding the whole dynamic partition every frame. Saves a lot of time in
+ * levels with many stationary surface objects. Objects that stop loading their collision have it removed once
+ * the surface objects have updated, rather than before. Surfaces at the same height keep the order of a full
+ * rebuild as long as the objects update in the same order every frame.
+ */
+// #define INCREMENTAL_DYNAMIC_SURFACES
+
+/**
+ * Sorts tangible objects into a coarse grid once per frame, so that object-object collision only tests pairs
+ * of objects whose hitboxes can actually touch, rather than every object against every object in the lists it
+ * collides with. Collisions are still detected in the same order as before. Mostly helps levels with many objects.
+ */
+// #define OBJECT_COLLISION_BROADPHASE
@@ -60,6 +60,35 @@
  */
 #define AREA_COUNT 8
 
+/**
+ * The most objects a level can add to the object pool with RESERVE_OBJECTS, on top of the usual 240.
+ * Reserved objects are allocated from the main pool when the level loads, but the per-object tables
+ * (collision and dynamic surfaces) are always sized for this many more, so it's 0 unless a level needs it.
+ * 256 is a good value if one does.
+ */
+#define MAX_RESERVED_OBJECTS 0
+
+/**
+ * Objects with OBJ_FLAG_REDUCED_UPDATE_RATE are only updated every 2nd frame when they're further than
+ * OBJECT_HALF_RATE_DIST from Mario, and every 4th frame when they're further than OBJECT_QUARTER_RATE_DIST
+ * or in a room Mario isn't in. Their oTimer still counts every frame, but the rest of the update is skipped:
+ * - anything the behavior does per update (such as moving by its forward velocity) happens less often,
+ * - oDistanceToMario and oAngleToMario are only refreshed when it updates,
+ * - interactions and attacks are only reacted to on its next update, and any hitbox or tangibility changes
+ *   the behavior makes wait until then too.
+ * Objects with a collision model always update every frame, since skipping would drop their surfaces.
+ * Only give the flag to behaviors where none of this matters from afar.
+ */
+// #define OBJECT_UPDATE_SCHEDULER
+#define OBJECT_HALF_RATE_DIST    3000.0f
+#define OBJECT_QUARTER_RATE_DIST 6000.0f
+
+/**
+ * Decodes behavior loops that only call native functions (BEGIN_LOOP, CALL_NATIVE..., END_LOOP) the first time
+ * an object enters them, so that each frame after that just calls the functions instead of interpreting the loop.
+ */
+#define BEHAVIOR_NATIVE_LOOPS
+
 /**
  * Makes signs and NPCs easier to talk to.
  */
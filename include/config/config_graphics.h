@@ -152,3 +152,26 @@
  * Only use this if you can test the difference of your hack with and without this change on console.
  */
 // #define USE_FRUSTRATIO2
+
+/**
+ * Sorts the objects within the opaque and alpha layers of each master list by their first texture,
+ * and then front to back, so that objects with the same material are drawn together.
+ * Each object's display lists keep their order, so render state set by one still applies to the rest.
+ * This can save RDP time in scenes with many objects. Transparent and decal layers keep their order.
+ */
+// #define SORT_DISPLAY_LISTS
+
+/**
+ * Reuses the matrices of level geometry and still objects from the last frame when nothing they depend on
+ * has changed, instead of building new ones every frame. This is how many nodes can be cached, each taking
+ * about 250 bytes. Parts of object models are not cached, since the same nodes are drawn for every object.
+ */
+// #define MATRIX_CACHE_SIZE 128
+
+/**
+ * Decodes the pose of each animation frame that is drawn only once per frame, and shares it between every object
+ * showing that frame, instead of looking up each value for every object. This helps most with crowds of the same
+ * enemy. This is how many different animation frames can be cached per frame.
+ * Animations converted with tools/bake_animations.py don't need to be decoded at all, with or without this.
+ */
+// #define ANIMATION_POSE_CACHE 64
@@ -49,6 +49,20 @@
     #undef BETTER_REVERB
 #endif
 
+#if defined(AUDIBILITY_NOTE_STEALING) && !(defined(VERSION_US) || defined(VERSION_JP))
+    #undef AUDIBILITY_NOTE_STEALING
+#endif
+
+/*****************
+ * config_collision.h
+ */
+
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+    #undef FLAT_STATIC_PARTITION
+    #define FLAT_STATIC_PARTITION // The Y buckets index the flattened static partition.
+#endif // STATIC_PARTITION_Y_BUCKET_SIZE
+
+
 /*****************
  * config_debug.h
  */
@@ -58,6 +58,7 @@ enum GeoLayoutCommands {
     /*0x1E*/ GEO_CMD_NOP_1E,
     /*0x1F*/ GEO_CMD_NOP_1F,
     /*0x20*/ GEO_CMD_NODE_CULLING_RADIUS,
+    /*0x21*/ GEO_CMD_NODE_CULLING_BOX,
 
     GEO_CMD_COUNT,
 };
@@ -469,4 +470,18 @@ enum GeoLayoutCommands {
 #define GEO_CULLING_RADIUS(cullingRadius) \
     CMD_BBH(GEO_CMD_NODE_CULLING_RADIUS, 0x00, cullingRadius)
 
+/**
+ * 0x21: Create a scene graph node whose children are only drawn if the given box, in the
+ * coordinates of its parent, is at least partly in view. Used for chunks of level geometry.
+ *   0x01: unused
+ *   0x02: unused
+ *   0x04: s16 minX, minY, minZ
+ *   0x0A: s16 maxX, maxY, maxZ
+ */
+#define GEO_CULLING_BOX(minX, minY, minZ, maxX, maxY, maxZ) \
+    CMD_BBH(GEO_CMD_NODE_CULLING_BOX, 0x00, 0x0000), \
+    CMD_HH(minX, minY), \
+    CMD_HH(minZ, maxX), \
+    CMD_HH(maxY, maxZ)
+
 #endif // GEO_COMMANDS_H
@@ -55,5 +55,11 @@ extern int	flush_window(void);
 //
 u32   expand_gzip(u8 *src_addr, u8 *dst_addr, u32 size, u32 outbytes_limit);
 
+// Streamed inflation, for input that is read in a piece at a time.
+// expand_gzip_stream returns 0 (Z_OK) while it needs more input, and 1 (Z_STREAM_END) once done.
+s32   expand_gzip_stream_start(u8 *dst_addr, u32 outbytes_limit);
+s32   expand_gzip_stream(u8 *src_addr, u32 size);
+s32   expand_gzip_stream_end(void);
+
 
 #endif
@@ -71,6 +71,7 @@ enum LevelCommands {
     /*0x3D*/ LEVEL_CMD_PUPPYVOLUME,
     /*0x3E*/ LEVEL_CMD_CHANGE_AREA_SKYBOX,
     /*0x3F*/ LEVEL_CMD_SET_ECHO,
+    /*0x40*/ LEVEL_CMD_RESERVE_OBJECTS,
 };
 
 enum LevelActs {
@@ -449,6 +450,11 @@ enum GoddardScene {
 #define SET_ECHO(console, emulator) \
     CMD_BBBB(LEVEL_CMD_SET_ECHO, 0x04, console, emulator)
 
+// Adds count objects to the object pool until the level is unloaded. Use this after INIT_LEVEL, at most once per level.
+// It must come before ALLOC_LEVEL_POOL, which takes the rest of the main pool.
+#define RESERVE_OBJECTS(count) \
+    CMD_BBH(LEVEL_CMD_RESERVE_OBJECTS, 0x04, count)
+
 #define MACRO_OBJECTS(objList) \
     CMD_BBH(LEVEL_CMD_SET_MACRO_OBJECTS, 0x08, 0x0000), \
     CMD_PTR(objList)
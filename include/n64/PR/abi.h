@@ -234,8 +234,15 @@ typedef struct {
  */
 
 typedef struct {
+#ifdef AUDIO_RENDER
+    // The host audio renderer (tools/audio_render) keeps the 8 byte commands the audio code
+    // steps through as u64s, so its audio memory has to be addressable with 32 bits.
+    unsigned int w0;
+    unsigned int w1;
+#else
     uintptr_t w0;
     uintptr_t w1;
+#endif
 } Awords;
 
 typedef union {
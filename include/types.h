@@ -201,6 +201,7 @@ enum AnimFlags {
     ANIM_FLAG_DISABLED   = BIT(5), // 0x20
     ANIM_FLAG_NO_TRANS   = BIT(6), // 0x40
     ANIM_FLAG_UNUSED     = BIT(7), // 0x80
+    ANIM_FLAG_BAKED      = BIT(8), // 0x100, see tools/bake_animations.py
 };
 
 struct Animation {
@@ -212,7 +213,7 @@ struct Animation {
     /*0x0A*/ s16 unusedBoneCount;
     /*0x0C*/ const s16 *values;
     /*0x10*/ const u16 *index;
-    /*0x14*/ u32 length; // only used with Mario animations to determine how much to load. 0 otherwise.
+    /*0x14*/ u32 length; // only used with Mario animations to determine how much to load, and the number of frames of baked animations. 0 otherwise.
 };
 
 #define ANIMINDEX_NUMPARTS(animindex) (sizeof(animindex) / sizeof(u16) / 6 - 1)
@@ -300,7 +301,8 @@ struct Object {
         const void *asConstVoidPtr[MAX_OBJECT_FIELDS];
     } ptrData;
 #endif
-    /*0x1C8*/ u32 unused1;
+    /*0x1C8*/ s16 framesSkipped; // Frames the update scheduler skipped since the last update
+    /*0x1CA*/ s16 unused1;
     /*0x1CC*/ const BehaviorScript *curBhvCommand;
     /*0x1D0*/ u32 bhvStackIndex;
     /*0x1D4*/ uintptr_t bhvStack[8];
@@ -312,7 +314,7 @@ struct Object {
     /*0x204*/ f32 hurtboxHeight;
     /*0x208*/ f32 hitboxDownOffset;
     /*0x20C*/ const BehaviorScript *behavior;
-    /*0x210*/ u32 unused2;
+    /*0x210*/ struct BhvNativeLoop *nativeLoop; // The decoded loop curBhvCommand is at the start of, if any
     /*0x214*/ struct Object *platform;
     /*0x218*/ void *collisionData;
     /*0x21C*/ Mat4 transform;
@@ -677,7 +677,13 @@ struct Note {
     /*0x00*/ u8 usesHeadsetPanEffects : 1;
     /*0x01*/ u8 stereoStrongRight     : 1;
     /*0x01*/ u8 stereoStrongLeft      : 1;
+#ifdef VIRTUAL_VOICES
+    /*0x01*/ u8 virtualVoice          : 1; // Skipped by synthesis_process_notes while inaudible
+#endif
 #else
+#ifdef VIRTUAL_VOICES
+    /*0x00*/ u8 virtualVoice          : 1; // Skipped by synthesis_process_notes while inaudible
+#endif
     /*    */ u8 pad0[0x01];
 #endif
     /*0x02*/ u8 sampleDmaIndex;
@@ -713,6 +719,9 @@ struct Note {
     /*0xA6*/ u16 prevHeadsetPanLeft;
     /*    */ u8 align16Padding[0x08];
 #endif
+#ifdef AUDIBILITY_NOTE_STEALING
+    /*    */ u16 age; // Audio updates since the note started playing its current layer
+#endif
 }; // size = 0xA0, 0xB0
 #endif
 
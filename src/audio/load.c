@@ -14,9 +14,20 @@ struct SharedDma {
     /*0x4*/ uintptr_t source; // device address
     /*0x8*/ u32 bufSize;      // size of buffer (converted from u16 for intentional padding to size 0x10)
     /*0xC*/ u8 reuseIndex;    // position in sSampleDmaReuseQueue1/2, if ttl == 0
-    /*   */ // u8 pad[3];
+    /*   */ // u8 pad;
+    /*0xE*/ u16 indexNext;    // next DMA in the same sSampleDmaIndex bucket, or SAMPLE_DMA_NONE
 };                            // size = 0x10
 
+// The second list's DMAs are looked up by address, so they're hashed by their source address.
+// A bucket spans at least one DMA buffer, so a DMA covering an address starts either in the
+// address's bucket or in the one before it.
+#define SAMPLE_DMA_INDEX_SHIFT   11
+#define SAMPLE_DMA_INDEX_BUCKETS 64
+#define SAMPLE_DMA_NONE          0xFFFF
+#define SAMPLE_DMA_BUCKET(addr)  (((addr) >> SAMPLE_DMA_INDEX_SHIFT) & (SAMPLE_DMA_INDEX_BUCKETS - 1))
+
+STATIC_ASSERT((1 << SAMPLE_DMA_INDEX_SHIFT) >= DMA_BUF_SIZE_1, "Sample DMA index buckets must span a whole DMA buffer!");
+
 // EU only
 void port_eu_init(void);
 
@@ -53,6 +64,9 @@ u8 sSampleDmaReuseQueueTail2;
 u8 sSampleDmaReuseQueueHead1; // sh: 0x803505E2
 u8 sSampleDmaReuseQueueHead2; // sh: 0x803505E3
 
+// Heads of the hash chains of DMAs in the second list, linked through indexNext.
+u16 sSampleDmaIndex[SAMPLE_DMA_INDEX_BUCKETS];
+
 // bss correct up to here
 
 ALSeqFile *gSeqFileHeader;
@@ -176,6 +190,51 @@ void decrease_sample_dma_ttls() {
     }
 }
 
+static void sample_dma_index_insert(u32 dmaIndex) {
+    u16 *head = &sSampleDmaIndex[SAMPLE_DMA_BUCKET(sSampleDmas[dmaIndex].source)];
+
+    sSampleDmas[dmaIndex].indexNext = *head;
+    *head = dmaIndex;
+}
+
+static void sample_dma_index_remove(u32 dmaIndex) {
+    u16 *link = &sSampleDmaIndex[SAMPLE_DMA_BUCKET(sSampleDmas[dmaIndex].source)];
+
+    // DMAs that were never loaded aren't in any bucket, in which case this finds nothing.
+    while (*link != SAMPLE_DMA_NONE) {
+        if (*link == dmaIndex) {
+            *link = sSampleDmas[dmaIndex].indexNext;
+            return;
+        }
+        link = &sSampleDmas[*link].indexNext;
+    }
+}
+
+/**
+ * Finds a DMA in the second list that holds size bytes at devAddr, or returns SAMPLE_DMA_NONE.
+ * Of several such DMAs, this returns the lowest index, like a scan of the list would.
+ */
+static u32 sample_dma_index_find(uintptr_t devAddr, u32 size) {
+    u32 found = SAMPLE_DMA_NONE;
+    u32 bucket = SAMPLE_DMA_BUCKET(devAddr);
+    s32 i;
+
+    for (i = 0; i < 2; i++) {
+        u32 dmaIndex = sSampleDmaIndex[bucket];
+        while (dmaIndex != SAMPLE_DMA_NONE) {
+            struct SharedDma *dma = &sSampleDmas[dmaIndex];
+            ssize_t bufferPos = devAddr - dma->source;
+            if (dmaIndex < found && 0 <= bufferPos && (size_t) bufferPos <= dma->bufSize - size) {
+                found = dmaIndex;
+            }
+            dmaIndex = dma->indexNext;
+        }
+        bucket = (bucket - 1) & (SAMPLE_DMA_INDEX_BUCKETS - 1);
+    }
+
+    return found;
+}
+
 void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
     s32 hasDma = FALSE;
     struct SharedDma *dma;
@@ -186,26 +245,24 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
     ssize_t bufferPos;
 
     if (arg2 != 0 || *dmaIndexRef >= sSampleDmaListSize1) {
-        for (i = sSampleDmaListSize1; i < gSampleDmaNumListItems; i++) {
+        i = sample_dma_index_find(devAddr, size);
+        if (i != SAMPLE_DMA_NONE) {
             dma = &sSampleDmas[i];
-            bufferPos = devAddr - dma->source;
-            if (0 <= bufferPos && (size_t) bufferPos <= dma->bufSize - size) {
-                // We already have a DMA request for this memory range.
-                if (sSampleTTLs[i] == 0 && sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2) {
-                    // Move the DMA out of the reuse queue, by swapping it with the
-                    // tail, and then incrementing the tail.
-                    if (dma->reuseIndex != sSampleDmaReuseQueueTail2) {
-                        sSampleDmaReuseQueue2[dma->reuseIndex] =
-                            sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2];
-                        sSampleDmas[sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2]].reuseIndex =
-                            dma->reuseIndex;
-                    }
-                    sSampleDmaReuseQueueTail2++;
+            // We already have a DMA request for this memory range.
+            if (sSampleTTLs[i] == 0 && sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2) {
+                // Move the DMA out of the reuse queue, by swapping it with the
+                // tail, and then incrementing the tail.
+                if (dma->reuseIndex != sSampleDmaReuseQueueTail2) {
+                    sSampleDmaReuseQueue2[dma->reuseIndex] =
+                        sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2];
+                    sSampleDmas[sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2]].reuseIndex =
+                        dma->reuseIndex;
                 }
-                sSampleTTLs[i] = 60;
-                *dmaIndexRef = (u8) i;
-                return (devAddr - dma->source) + dma->buffer;
+                sSampleDmaReuseQueueTail2++;
             }
+            sSampleTTLs[i] = 60;
+            *dmaIndexRef = (u8) i;
+            return (devAddr - dma->source) + dma->buffer;
         }
 
         if (sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2 && arg2 != 0) {
@@ -249,7 +306,13 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
 
     transfer = dma->bufSize;
     dmaDevAddr = devAddr & ~0xF;
-    dma->source = dmaDevAddr;
+    if (dmaIndex >= sSampleDmaListSize1) {
+        sample_dma_index_remove(dmaIndex);
+        dma->source = dmaDevAddr;
+        sample_dma_index_insert(dmaIndex);
+    } else {
+        dma->source = dmaDevAddr;
+    }
 #ifdef VERSION_US // TODO: Is there a reason this only exists in US?
     osInvalDCache(dma->buffer, transfer);
 #endif
@@ -320,6 +383,10 @@ void init_sample_dma_buffers() {
 
     sSampleDmaReuseQueueTail2 = 0;
     sSampleDmaReuseQueueHead2 = gSampleDmaNumListItems - sSampleDmaListSize1;
+
+    for (i = 0; i < ARRAY_COUNT(sSampleDmaIndex); i++) {
+        sSampleDmaIndex[i] = SAMPLE_DMA_NONE;
+    }
 }
 
 #if defined(VERSION_JP) || defined(VERSION_US)
@@ -9,6 +9,21 @@
 #include "effects.h"
 #include "external.h"
 
+#ifdef AUDIO_PROFILING
+struct NoteAllocStats gNoteAllocStats;
+#define NOTE_ALLOC_STATS_ADD(field) (gNoteAllocStats.field++)
+#else
+#define NOTE_ALLOC_STATS_ADD(field)
+#endif
+
+#ifdef AUDIBILITY_NOTE_STEALING
+// Notes younger than this many audio updates are never picked over an older note of the same priority,
+// since their volume hasn't settled yet and cutting off an attack is the most noticeable.
+#define NOTE_STEAL_MIN_AGE 8
+// Notes quieter than this (Q1.15, so about -42 dB) can be stolen by a note of any priority.
+#define NOTE_STEAL_QUIET_VOLUME 0x100
+#endif
+
 void note_set_resampling_rate(struct Note *note, f32 resamplingRateInput);
 
 #if defined(VERSION_EU) || defined(VERSION_SH)
@@ -579,6 +594,11 @@ void process_notes(void) {
 
             adsr_update(note);
             note_vibrato_update(note);
+#ifdef AUDIBILITY_NOTE_STEALING
+            if (note->age != 0xFFFF) {
+                note->age++;
+            }
+#endif
             if (note->priority == NOTE_PRIORITY_STOPPING) {
                 struct NoteAttributes *attributes = &note->attributes;
                 frequency = attributes->freqScale;
@@ -1068,6 +1088,29 @@ void audio_list_remove(struct AudioListItem *item) {
     }
 }
 
+#ifdef AUDIBILITY_NOTE_STEALING
+/**
+ * How much cutting a note off would be missed: its priority, then how loud it is at the moment.
+ * The volume already includes the note's velocity, its envelope, and its channel's volume, which
+ * is where the sequence player's fade and a sound's distance from the camera come in.
+ */
+static u32 note_steal_cost(struct Note *note) {
+    u32 priority = note->priority;
+    u32 volume;
+
+    if (note->age < NOTE_STEAL_MIN_AGE) {
+        volume = 0xFFFF;
+    } else {
+        volume = MAX(note->targetVolLeft, note->targetVolRight);
+        if (volume < NOTE_STEAL_QUIET_VOLUME && priority > NOTE_PRIORITY_MIN) {
+            priority = NOTE_PRIORITY_MIN;
+        }
+    }
+
+    return (priority << 16) | volume;
+}
+#endif
+
 struct Note *pop_node_with_lower_prio(struct AudioListItem *list, s32 limit) {
     struct AudioListItem *cur = list->next;
     struct AudioListItem *best;
@@ -1076,11 +1119,27 @@ struct Note *pop_node_with_lower_prio(struct AudioListItem *list, s32 limit) {
         return NULL;
     }
 
+#ifdef AUDIBILITY_NOTE_STEALING
+    // Take the quietest note of the lowest priority. Ties go to the note furthest down the list, as before.
+    u32 bestCost = note_steal_cost(cur->u.value);
+    for (best = cur; cur != list; cur = cur->next) {
+        u32 cost = note_steal_cost(cur->u.value);
+        if (bestCost >= cost) {
+            bestCost = cost;
+            best = cur;
+        }
+    }
+
+    if ((u32) limit < (bestCost >> 16)) {
+        return NULL;
+    }
+#else
     for (best = cur; cur != list; cur = cur->next) {
         if (((struct Note *) best->u.value)->priority >= ((struct Note *) cur->u.value)->priority) {
             best = cur;
         }
     }
+#endif
 
 #if defined(VERSION_EU) || defined(VERSION_SH)
     if (best == NULL) {
@@ -1090,7 +1149,7 @@ struct Note *pop_node_with_lower_prio(struct AudioListItem *list, s32 limit) {
     if (limit <= ((struct Note *) best->u.value)->priority) {
         return NULL;
     }
-#else
+#elif !defined(AUDIBILITY_NOTE_STEALING)
     if (limit < ((struct Note *) best->u.value)->priority) {
         return NULL;
     }
@@ -1145,6 +1204,9 @@ s32 note_init_for_layer(struct Note *note, struct SequenceChannelLayer *seqLayer
     note->prevParentLayer = NO_LAYER;
     note->parentLayer = seqLayer;
     note->priority = seqLayer->seqChannel->notePriority;
+#ifdef AUDIBILITY_NOTE_STEALING
+    note->age = 0;
+#endif
     if (!IS_BANK_LOAD_COMPLETE(seqLayer->seqChannel->bankId)) {
         return TRUE;
     }
@@ -1236,6 +1298,7 @@ struct Note *alloc_note_from_active(struct NotePool *pool, struct SequenceChanne
 #ifdef VERSION_SH
         aPriority = aNote->priority;
 #else
+        NOTE_ALLOC_STATS_ADD(steals);
         func_80319728(aNote, seqLayer);
         audio_list_push_back(&pool->releasing, &aNote->listItem);
 #endif
@@ -1291,6 +1354,7 @@ struct Note *alloc_note(struct SequenceChannelLayer *seqLayer) {
             goto null_return;
 #else
             eu_stubbed_printf_0("Sub Limited Warning: Drop Voice");
+            NOTE_ALLOC_STATS_ADD(drops);
             seqLayer->status = SOUND_LOAD_STATUS_NOT_LOADED;
             return NULL;
 #endif
@@ -1309,6 +1373,7 @@ struct Note *alloc_note(struct SequenceChannelLayer *seqLayer) {
             goto null_return;
 #else
             eu_stubbed_printf_0("Warning: Drop Voice");
+            NOTE_ALLOC_STATS_ADD(drops);
             seqLayer->status = SOUND_LOAD_STATUS_NOT_LOADED;
             return NULL;
 #endif
@@ -1324,6 +1389,7 @@ struct Note *alloc_note(struct SequenceChannelLayer *seqLayer) {
             goto null_return;
 #else
             eu_stubbed_printf_0("Warning: Drop Voice");
+            NOTE_ALLOC_STATS_ADD(drops);
             seqLayer->status = SOUND_LOAD_STATUS_NOT_LOADED;
             return NULL;
 #endif
@@ -1344,6 +1410,7 @@ struct Note *alloc_note(struct SequenceChannelLayer *seqLayer) {
         goto null_return;
 #else
         eu_stubbed_printf_0("Warning: Drop Voice");
+        NOTE_ALLOC_STATS_ADD(drops);
         seqLayer->status = SOUND_LOAD_STATUS_NOT_LOADED;
         return NULL;
 #endif
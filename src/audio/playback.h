@@ -4,6 +4,7 @@
 #include <PR/ultratypes.h>
 
 #include "internal.h"
+#include "game/profiling.h"
 
 // Mask bits denoting where to allocate notes from, according to a channel's
 // noteAllocPolicy. Despite being checked as bitmask bits, the bits are not
@@ -18,6 +19,16 @@ enum NoteAlloc {
     NOTE_ALLOC_GLOBAL_FREELIST = (1 << 3), // 0x8
 };
 
+#ifdef AUDIO_PROFILING
+// Counts of notes that had to be taken from another layer, or couldn't be allocated at all.
+struct NoteAllocStats {
+    u32 steals;
+    u32 drops;
+};
+
+extern struct NoteAllocStats gNoteAllocStats;
+#endif
+
 void process_notes(void);
 void seq_channel_layer_note_decay(struct SequenceChannelLayer *seqLayer);
 void seq_channel_layer_note_release(struct SequenceChannelLayer *seqLayer);
@@ -84,14 +84,78 @@ f32 *currentRampingTableLeft;
 f32 *currentRampingTableRight;
 
 #ifdef BETTER_REVERB
+// Per-sample state of the block being processed by reverb_samples: the signal travelling between filters, and the output sum.
+static s32 reverbBlockCarryover[DEFAULT_LEN_1CH / sizeof(s16)];
+static s32 reverbBlockOut[DEFAULT_LEN_1CH / sizeof(s16)];
+
+/**
+ * Run one allpass filter over a block of samples. The block is split where the delay line wraps around,
+ * so the inner loop needs no index checks.
+ */
+static void reverb_allpass_block(s16 *delayBuf, s32 *idx, s32 delay, s32 *carryover, s32 numSamples, s32 gainIndex) {
+    s32 pos = *idx;
+
+    while (numSamples > 0) {
+        s32 span = MIN(numSamples, delay - pos);
+        s16 *curDelaySample = &delayBuf[pos];
+
+        for (s32 n = 0; n < span; n++) {
+            s32 historySample = curDelaySample[n];
+            s32 tmpCarryover = carryover[n] + ((historySample * (-gainIndex)) >> 8);
+            curDelaySample[n] = CLAMP_S16(tmpCarryover);
+            carryover[n] = ((tmpCarryover * gainIndex) >> 8) + historySample;
+        }
+
+        carryover += span;
+        numSamples -= span;
+        pos += span;
+        if (pos == delay) pos = 0;
+    }
+
+    *idx = pos;
+}
+
+/**
+ * Run the third filter of a group over a block of samples: its delayed output is added to the reverb output,
+ * and scaled by revIndex to become the input of the next group.
+ */
+static void reverb_output_block(s16 *delayBuf, s32 *idx, s32 delay, s32 *carryover, s32 *out, s32 numSamples, s32 mult, s32 revIndex) {
+    s32 pos = *idx;
+
+    while (numSamples > 0) {
+        s32 span = MIN(numSamples, delay - pos);
+        s16 *curDelaySample = &delayBuf[pos];
+
+        for (s32 n = 0; n < span; n++) {
+            s32 historySample = curDelaySample[n];
+            out[n] += ((historySample * mult) >> 8);
+            curDelaySample[n] = CLAMP_S16(carryover[n]);
+            // Unused after the last filter
+            carryover[n] = ((historySample * revIndex) >> 8);
+        }
+
+        carryover += span;
+        out += span;
+        numSamples -= span;
+        pos += span;
+        if (pos == delay) pos = 0;
+    }
+
+    *idx = pos;
+}
+
+/**
+ * Full reverb processing, one filter at a time over blocks of samples rather than one sample at a time through every filter.
+ * Each sample's input includes the last filter's output from a full delay earlier, so a block is never longer than
+ * the last filter's delay; within that, the result is identical to running the samples through one by one.
+ */
 static void reverb_samples(s16 *start, s16 *end, s16 *downsampleBuffer, s32 channel) {
-    s16 *curDelaySample;
-    s32 historySample;
-    s32 tmpCarryover;
-    s32 outSampleTotal;
+    s32 *carryover = reverbBlockCarryover;
+    s32 *out = reverbBlockOut;
+    s32 numSamples;
     s32 i;
-    s32 j;
     s32 k;
+    s32 n;
 
     s32 downsampleIncrement = gReverbDownsampleRate;
     s32 *delaysLocal = betterReverbDelays[channel];
@@ -103,44 +167,41 @@ static void reverb_samples(s16 *start, s16 *end, s16 *downsampleBuffer, s32 chan
     s32 revIndex = betterReverbRevIndex;
     s32 gainIndex = betterReverbGainIndex;
 
-    // Set j outside of the loop only. Because we're forcing filter count to always be a multiple of 3, we can count on j always being 0 when exiting the second for loop.
-    j = 0;
-
-    for (; start < end; start++, downsampleBuffer += downsampleIncrement) {
-        // Mix the very last filter output with new incoming sample
-        tmpCarryover = ((delayBufsLocal[lastFilterIndex][allpassIdxLocal[lastFilterIndex]] * revIndex) >> 8) + *downsampleBuffer;
-        outSampleTotal = 0;
-        i = 0;
-        k = 0;
-
-        for (; i <= lastFilterIndex; ++i, ++j) {
-            curDelaySample = &delayBufsLocal[i][allpassIdxLocal[i]];
-            historySample = *curDelaySample;
-
-            if (j == 2) {
-                j = -1;
-                outSampleTotal += ((historySample * reverbMultsLocal[k++]) >> 8);
-                *curDelaySample = CLAMP_S16(tmpCarryover);
-                if (i != lastFilterIndex)
-                    tmpCarryover = ((historySample * revIndex) >> 8)/* + *downsampleBuffer*/;
-            } else {
-                tmpCarryover += (historySample * (-gainIndex)) >> 8;
-                *curDelaySample = CLAMP_S16(tmpCarryover);
-                tmpCarryover = ((tmpCarryover * gainIndex) >> 8) + historySample;
-            }
+    s16 *lastDelayBuf = delayBufsLocal[lastFilterIndex];
+    s32 lastDelay = delaysLocal[lastFilterIndex];
+
+    for (; start < end; start += numSamples) {
+        numSamples = MIN(end - start, (s32) ARRAY_COUNT(reverbBlockCarryover));
+        numSamples = MIN(numSamples, lastDelay);
+
+        // Mix the very last filter output with new incoming samples
+        s32 pos = allpassIdxLocal[lastFilterIndex];
+        for (n = 0; n < numSamples; n++, downsampleBuffer += downsampleIncrement) {
+            carryover[n] = ((lastDelayBuf[pos] * revIndex) >> 8) + *downsampleBuffer;
+            out[n] = 0;
+            if (++pos == lastDelay) pos = 0;
+        }
 
-            if (++allpassIdxLocal[i] == delaysLocal[i]) allpassIdxLocal[i] = 0;
+        // Filters come in groups of 3: two allpass filters, then one that feeds the output.
+        for (i = 0, k = 0; i < lastFilterIndex; i += 3, k++) {
+            reverb_allpass_block(delayBufsLocal[i], &allpassIdxLocal[i], delaysLocal[i], carryover, numSamples, gainIndex);
+            reverb_allpass_block(delayBufsLocal[i + 1], &allpassIdxLocal[i + 1], delaysLocal[i + 1], carryover, numSamples, gainIndex);
+            reverb_output_block(delayBufsLocal[i + 2], &allpassIdxLocal[i + 2], delaysLocal[i + 2], carryover, out, numSamples, reverbMultsLocal[k], revIndex);
         }
 
-        *start = CLAMP_S16(outSampleTotal);
+        for (n = 0; n < numSamples; n++) {
+            start[n] = CLAMP_S16(out[n]);
+        }
     }
 }
 
 static void reverb_samples_light(s16 *start, s16 *end, s16 *downsampleBuffer, s32 channel) {
-    s16 *curDelaySample;
+    s16 *curDelaySamples[BETTER_REVERB_FILTER_COUNT_LIGHT];
     s32 historySample;
     s32 tmpCarryover;
+    s32 numSamples;
     s32 i;
+    s32 n;
 
     s32 downsampleIncrement = gReverbDownsampleRate;
     s32 *delaysLocal = betterReverbDelays[channel];
@@ -150,25 +211,37 @@ static void reverb_samples_light(s16 *start, s16 *end, s16 *downsampleBuffer, s3
     // Get history sample from last processing tick
     tmpCarryover = historySamplesLight[channel];
 
-    for (; start < end; start++, downsampleBuffer += downsampleIncrement) {
-        // Mix previous sample with new incoming sample
-        tmpCarryover = ((tmpCarryover * BETTER_REVERB_REVERB_INDEX_LIGHT) >> 8) + *downsampleBuffer;
-
+    // Each sample depends on the one before it, so this can't work a filter at a time like reverb_samples.
+    // Instead, go through the samples in runs where none of the delay lines wrap around.
+    for (; start < end; start += numSamples) {
+        numSamples = end - start;
         for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; ++i) {
-            curDelaySample = &delayBufsLocal[i][allpassIdxLocal[i]];
-            historySample = *curDelaySample;
+            curDelaySamples[i] = &delayBufsLocal[i][allpassIdxLocal[i]];
+            numSamples = MIN(numSamples, delaysLocal[i] - allpassIdxLocal[i]);
+        }
 
-            tmpCarryover += ((historySample * (-BETTER_REVERB_GAIN_INDEX_LIGHT)) >> 8);
-            *curDelaySample = CLAMP_S16(tmpCarryover);
-            tmpCarryover = ((tmpCarryover * BETTER_REVERB_GAIN_INDEX_LIGHT) >> 8) + historySample;
+        for (n = 0; n < numSamples; n++, downsampleBuffer += downsampleIncrement) {
+            // Mix previous sample with new incoming sample
+            tmpCarryover = ((tmpCarryover * BETTER_REVERB_REVERB_INDEX_LIGHT) >> 8) + *downsampleBuffer;
+
+            for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; ++i) {
+                historySample = curDelaySamples[i][n];
+
+                tmpCarryover += ((historySample * (-BETTER_REVERB_GAIN_INDEX_LIGHT)) >> 8);
+                curDelaySamples[i][n] = CLAMP_S16(tmpCarryover);
+                tmpCarryover = ((tmpCarryover * BETTER_REVERB_GAIN_INDEX_LIGHT) >> 8) + historySample;
+            }
 
-            if (++allpassIdxLocal[i] == delaysLocal[i]) allpassIdxLocal[i] = 0;
+            // Lightweight does not use the final filter type at all, unlike standard reverb processing
+            start[n] = CLAMP_S16(tmpCarryover);
         }
 
-        // Lightweight does not use the final filter type at all, unlike standard reverb processing
-        *start = CLAMP_S16(tmpCarryover);
+        for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; ++i) {
+            allpassIdxLocal[i] += numSamples;
+            if (allpassIdxLocal[i] == delaysLocal[i]) allpassIdxLocal[i] = 0;
+        }
     }
-    
+
     // Copy history sample to temporary buffer for processing next tick
     historySamplesLight[channel] = tmpCarryover;
 }
@@ -210,6 +283,33 @@ void set_better_reverb_buffers(u32 *inputDelaysL, u32 *inputDelaysR) {
 
     bzero(allpassIdx, sizeof(allpassIdx));
 }
+
+void update_better_reverb_parameters(void) {
+    s32 filterCountDiv3 = reverbFilterCount / 3;
+    reverbFilterCount = filterCountDiv3 * 3; // reverbFilterCount should always be a multiple of 3.
+
+    if (reverbFilterCount > NUM_ALLPASS) {
+        reverbFilterCount = NUM_ALLPASS;
+    } else if (reverbFilterCount < 3) {
+        reverbFilterCount = 3;
+    }
+
+    reverbLastFilterIndex = reverbFilterCount - 1;
+
+    // Update reverbMults every audio frame just in case gReverbMults is ever to change.
+    if (gReverbMults[SYNTH_CHANNEL_LEFT] != NULL && gReverbMults[SYNTH_CHANNEL_RIGHT] != NULL) {
+        for (s32 i = 0; i < filterCountDiv3; ++i) {
+            reverbMults[SYNTH_CHANNEL_LEFT][i] = gReverbMults[SYNTH_CHANNEL_LEFT][i];
+            reverbMults[SYNTH_CHANNEL_RIGHT][i] = gReverbMults[SYNTH_CHANNEL_RIGHT][i];
+        }
+    }
+
+    // If there's only one reverb multiplier set, adjust these to match so one channel doesn't end up potentially overpowering the other.
+    if (filterCountDiv3 == 1) {
+        reverbMults[SYNTH_CHANNEL_LEFT][0] = (reverbMults[SYNTH_CHANNEL_RIGHT][0] + reverbMults[SYNTH_CHANNEL_LEFT][0]) / 2;
+        reverbMults[SYNTH_CHANNEL_RIGHT][0] = reverbMults[SYNTH_CHANNEL_LEFT][0];
+    }
+}
 #endif
 
 void prepare_reverb_ring_buffer(s32 chunkLen, u32 updateIndex) {
@@ -335,30 +435,7 @@ u64 *synthesis_execute(u64 *cmdBuf, s32 *writtenCmds, s16 *aiBuf, s32 bufLen) {
     aSegment(cmdBuf, 0, 0);
 
 #ifdef BETTER_REVERB
-    s32 filterCountDiv3 = reverbFilterCount / 3;
-    reverbFilterCount = filterCountDiv3 * 3; // reverbFilterCount should always be a multiple of 3.
-
-    if (reverbFilterCount > NUM_ALLPASS) {
-        reverbFilterCount = NUM_ALLPASS;
-    } else if (reverbFilterCount < 3) {
-        reverbFilterCount = 3;
-    }
-
-    reverbLastFilterIndex = reverbFilterCount - 1;
-
-    // Update reverbMults every audio frame just in case gReverbMults is ever to change.
-    if (gReverbMults[SYNTH_CHANNEL_LEFT] != NULL && gReverbMults[SYNTH_CHANNEL_RIGHT] != NULL) {
-        for (i = 0; i < filterCountDiv3; ++i) {
-            reverbMults[SYNTH_CHANNEL_LEFT][i] = gReverbMults[SYNTH_CHANNEL_LEFT][i];
-            reverbMults[SYNTH_CHANNEL_RIGHT][i] = gReverbMults[SYNTH_CHANNEL_RIGHT][i];
-        }
-    }
-
-    // If there's only one reverb multiplier set, adjust these to match so one channel doesn't end up potentially overpowering the other.
-    if (filterCountDiv3 == 1) {
-        reverbMults[SYNTH_CHANNEL_LEFT][0] = (reverbMults[SYNTH_CHANNEL_RIGHT][0] + reverbMults[SYNTH_CHANNEL_LEFT][0]) / 2;
-        reverbMults[SYNTH_CHANNEL_RIGHT][0] = reverbMults[SYNTH_CHANNEL_LEFT][0];
-    }
+    update_better_reverb_parameters();
 #endif
 
     for (i = gAudioUpdatesPerFrame; i > 0; i--) {
@@ -480,6 +557,59 @@ u64 *synthesis_do_one_audio_update(s16 *aiBuf, u32 bufLen, u64 *cmd, s32 updateI
     return cmd;
 }
 
+#ifdef VIRTUAL_VOICES
+/**
+ * Whether a note is at the smallest volume step (see note_set_vel_pan_reverb) on both sides for this
+ * whole update, in which case it adds at most one LSB to any sample and its synthesis can be skipped.
+ */
+static s32 note_is_inaudible(struct Note *note) {
+#ifdef ENABLE_STEREO_HEADSET_EFFECTS
+    // Headset panning carries samples over into the next update, so these notes always run.
+    if (note->usesHeadsetPanEffects) {
+        return FALSE;
+    }
+#endif
+    return (note->targetVolLeft <= 1 && note->targetVolRight <= 1
+            && note->curVolLeft <= 1 && note->curVolRight <= 1);
+}
+
+/**
+ * Advances a virtual voice by nSamples without making any audio commands, looping or finishing
+ * its sample the same way synthesis_process_notes would.
+ */
+static void note_advance_virtual(struct Note *note, s32 nSamples) {
+    struct AdpcmLoop *loopInfo;
+    s32 samplesRemaining;
+
+    if (note->sound == NULL) {
+        // Wave samples repeat forever, and load_wave_samples wraps the position.
+        note->samplePosInt += nSamples;
+        return;
+    }
+
+    loopInfo = note->sound->sample->loop;
+    while (TRUE) {
+        samplesRemaining = loopInfo->end - note->samplePosInt;
+        if (nSamples < samplesRemaining) {
+            note->samplePosInt += nSamples;
+            return;
+        }
+
+        if (loopInfo->count == 0) {
+            note->samplePosInt = 0;
+            note->finished = TRUE;
+            ((struct vNote *)note)->enabled = 0;
+            return;
+        }
+
+        // Loop around, and let the decoder restart from the loop's state once the note is audible.
+        nSamples -= samplesRemaining;
+        note->samplePosInt = loopInfo->start;
+        note->restart = TRUE;
+    }
+}
+#endif
+
 u64 *synthesis_process_notes(s16 *aiBuf, u32 bufLen, u64 *cmd) {
     s32 noteIndex;                           // sp174
     struct Note *note;                       // s7
@@ -573,6 +703,33 @@ u64 *synthesis_process_notes(s16 *aiBuf, u32 bufLen, u64 *cmd) {
             samplesLenFixedPoint = note->samplePosFrac + (resamplingRateFixedPoint * bufLen);
             note->samplePosFrac = samplesLenFixedPoint & 0xFFFF; // 16-bit store, can't reuse
 
+#ifdef VIRTUAL_VOICES
+            if (note_is_inaudible(note)) {
+                // Keep the note's position moving, but don't synthesize it. Its ADSR envelope is
+                // updated by the sequence player either way.
+                note_advance_virtual(note, nParts * (samplesLenFixedPoint >> 16));
+                note->needsInit = FALSE;
+                note->initFullVelocity = FALSE;
+                note->curVolLeft = note->targetVolLeft;
+                note->curVolRight = note->targetVolRight;
+                note->virtualVoice = TRUE;
+                continue;
+            }
+
+            if (note->virtualVoice) {
+                // The decoder and resampler states weren't kept up while the note was virtual,
+                // so start them over. Restarting the decoder from the loop's state is already
+                // exact, otherwise it resumes from the start of the current ADPCM frame.
+                note->virtualVoice = FALSE;
+                note->needsInit = TRUE;
+                note->envMixerNeedsInit = TRUE;
+                if (note->sound != NULL && !note->restart) {
+                    note->samplePosInt &= ~0xF;
+                    flags = A_INIT;
+                }
+            }
+#endif
+
             if (note->sound == NULL) {
                 // A wave synthesis note (not ADPCM)
 
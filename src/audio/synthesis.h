@@ -70,6 +70,7 @@ extern u8 *gReverbMults[SYNTH_CHANNEL_STEREO_COUNT];
 
 void initialize_better_reverb_buffers(void);
 void set_better_reverb_buffers(u32 *inputDelaysL, u32 *inputDelaysR);
+void update_better_reverb_parameters(void);
 
 
 /* -------------- BETTER REVERB STATIC ASSERTS -------------- */
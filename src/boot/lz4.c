@@ -0,0 +1,107 @@
+#include <PR/ultratypes.h>
+
+#include "macros.h"
+#include "lz4.h"
+
+/**
+ * Decoder for the LZ4 data made by tools/lz4pack, which trades some compression ratio for
+ * much cheaper decoding than Yay0 or DEFLATE: there are no control bits to shift through,
+ * and runs are copied 8 bytes at a time with unaligned word loads and stores.
+ *
+ * Copies can write up to 8 bytes past the end of a run. The output buffer has room for that,
+ * and lz4pack sizes it so that this never reaches compressed data that hasn't been read yet,
+ * which is what allows the data to be decompressed in place.
+ */
+
+typedef struct {
+    u32 value;
+} PACKED UnalignedWord;
+
+// The most that a sequence can read, not counting extra length bytes and literals.
+#define SEQUENCE_NEED 16
+
+static ALWAYS_INLINE void copy8(u8 *dest, u8 *src) {
+    u32 a = ((UnalignedWord *) src)[0].value;
+    u32 b = ((UnalignedWord *) src)[1].value;
+    ((UnalignedWord *) dest)[0].value = a;
+    ((UnalignedWord *) dest)[1].value = b;
+}
+
+/**
+ * Decompress the data at src to dest. waitForInput is called with the end of the input
+ * that is about to be read, and returns how far the input can be read.
+ */
+void lz4_decompress(u8 *src, u8 *dest, u32 size, u8 *(*waitForInput)(u8 *end)) {
+    u8 *in = (src + sizeof(struct Lz4Header));
+    u8 *inLimit = src;
+    u8 *out = dest;
+    u8 *outEnd = (dest + size);
+
+    while (TRUE) {
+        if ((in + SEQUENCE_NEED) > inLimit) {
+            inLimit = waitForInput(in + SEQUENCE_NEED);
+        }
+
+        u32 token = *in++;
+        u32 length = (token >> 4);
+
+        if (length == 15) {
+            u32 byte;
+            do {
+                if (in >= inLimit) {
+                    inLimit = waitForInput(in + SEQUENCE_NEED);
+                }
+                byte = *in++;
+                length += byte;
+            } while (byte == 255);
+        }
+
+        if ((in + length + SEQUENCE_NEED) > inLimit) {
+            inLimit = waitForInput(in + length + SEQUENCE_NEED);
+        }
+
+        u8 *runEnd = (out + length);
+        do {
+            copy8(out, in);
+            out += 8;
+            in += 8;
+        } while (out < runEnd);
+        in -= (out - runEnd);
+        out = runEnd;
+
+        // The last sequence has no match.
+        if (out >= outEnd) {
+            break;
+        }
+
+        u8 *match = (out - (in[0] | (in[1] << 8)));
+        in += 2;
+        length = (token & 0xF);
+
+        if (length == 15) {
+            u32 byte;
+            do {
+                if (in >= inLimit) {
+                    inLimit = waitForInput(in + SEQUENCE_NEED);
+                }
+                byte = *in++;
+                length += byte;
+            } while (byte == 255);
+        }
+
+        runEnd = (out + length + 4);
+        if ((out - match) >= 8) {
+            do {
+                copy8(out, match);
+                out += 8;
+                match += 8;
+            } while (out < runEnd);
+        } else {
+            // Short offsets repeat a pattern that the copy would read before it has been written.
+            do {
+                *out++ = *match++;
+            } while (out < runEnd);
+        }
+        out = runEnd;
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef LZ4_H
+#define LZ4_H
+
+#include <PR/ultratypes.h>
+
+/**
+ * Header of data packed by tools/lz4pack. It's followed by a single LZ4 block.
+ */
+struct Lz4Header {
+    u32 magic;        // "LZ4B"
+    u32 size;         // Decompressed size
+    u32 bufferSize;   // Size of the buffer needed to decompress in place
+    u32 fileSize;     // Size of the header and block, padded to 16 bytes
+};
+
+void lz4_decompress(u8 *src, u8 *dest, u32 size, u8 *(*waitForInput)(u8 *end));
+
+#endif // LZ4_H
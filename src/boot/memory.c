@@ -4,6 +4,7 @@
 
 #include "buffers/buffers.h"
 #include "slidec.h"
+#include "game/debug.h"
 #include "game/game_init.h"
 #include "game/main.h"
 #include "game/memory.h"
@@ -15,6 +16,9 @@
 #if defined(RNC1) || defined(RNC2)
 #include <rnc.h>
 #endif
+#ifdef LZ4
+#include "lz4.h"
+#endif
 #ifdef UNF
 #include "usb/usb.h"
 #include "usb/debug.h"
@@ -251,24 +255,94 @@ u32 main_pool_pop_state(void) {
 }
 
 /**
- * Perform a DMA read from ROM. The transfer is split into 4KB blocks, and this
- * function blocks until completion.
+ * ROM reads are split into blocks of DMA_STREAM_BLOCK_SIZE, and up to DMA_STREAM_DEPTH blocks are queued
+ * with the PI manager at once, so that the next block starts as soon as the last one is done instead of
+ * when this thread gets around to asking for it. Audio DMAs queue up behind these, so don't raise it too far.
  */
-void dma_read(u8 *dest, u8 *srcStart, u8 *srcEnd) {
+#define DMA_STREAM_BLOCK_SIZE 0x1000
+#define DMA_STREAM_DEPTH      3
+
+struct DmaStream {
+    u8 *dest;       // Where the next block will be read to
+    u8 *src;        // Where the next block will be read from
+    u8 *srcEnd;
+    u8 *landed;     // Everything before this has been read in
+    u32 numQueued;
+    u32 nextIoMesg;
+};
+
+static struct DmaStream sDmaStream;
+static OSIoMesg sDmaStreamIoMesgs[DMA_STREAM_DEPTH];
+static OSMesg sDmaStreamMesgBuf[DMA_STREAM_DEPTH];
+static OSMesgQueue sDmaStreamMesgQueue;
+
+/**
+ * Queue blocks with the PI manager until the stream has DMA_STREAM_DEPTH blocks in flight.
+ */
+static void dma_stream_queue_blocks(void) {
+    struct DmaStream *stream = &sDmaStream;
+
+    while (stream->numQueued < DMA_STREAM_DEPTH && stream->src < stream->srcEnd) {
+        u32 size = (stream->srcEnd - stream->src);
+        u32 copySize = (size >= DMA_STREAM_BLOCK_SIZE) ? DMA_STREAM_BLOCK_SIZE : size;
+
+        osPiStartDma(&sDmaStreamIoMesgs[stream->nextIoMesg], OS_MESG_PRI_NORMAL, OS_READ, (uintptr_t) stream->src,
+                     stream->dest, copySize, &sDmaStreamMesgQueue);
+
+        stream->nextIoMesg = ((stream->nextIoMesg + 1) % DMA_STREAM_DEPTH);
+        stream->numQueued++;
+        stream->dest += copySize;
+        stream->src += copySize;
+    }
+}
+
+/**
+ * Start reading srcStart through srcEnd from ROM to dest in the background. Only one stream can be read at a time.
+ */
+static void dma_stream_start(u8 *dest, u8 *srcStart, u8 *srcEnd) {
+    struct DmaStream *stream = &sDmaStream;
     u32 size = ALIGN16(srcEnd - srcStart);
 
     osInvalDCache(dest, size);
-    while (size != 0) {
-        u32 copySize = (size >= 0x1000) ? 0x1000 : size;
+    osCreateMesgQueue(&sDmaStreamMesgQueue, sDmaStreamMesgBuf, ARRAY_COUNT(sDmaStreamMesgBuf));
+
+    stream->dest = dest;
+    stream->src = srcStart;
+    stream->srcEnd = (srcStart + size);
+    stream->landed = dest;
+    stream->numQueued = 0;
+    stream->nextIoMesg = 0;
+
+    dma_stream_queue_blocks();
+}
+
+/**
+ * Block until the stream has been read in up to at least end, or until the whole stream has been read if end is NULL.
+ * Blocks are always a multiple of the data cache line size, so everything before the returned address can be read.
+ * Returns how far the stream has been read in.
+ */
+static u8 *dma_stream_wait(u8 *end) {
+    struct DmaStream *stream = &sDmaStream;
+    OSMesg mesg;
 
-        osPiStartDma(&gDmaIoMesg, OS_MESG_PRI_NORMAL, OS_READ, (uintptr_t) srcStart, dest, copySize,
-                     &gDmaMesgQueue);
-        osRecvMesg(&gDmaMesgQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
+    while (stream->numQueued != 0 && (end == NULL || stream->landed < end)) {
+        // The PI manager handles requests in order, so blocks land in the order they were queued.
+        osRecvMesg(&sDmaStreamMesgQueue, &mesg, OS_MESG_BLOCK);
+        stream->landed += ((OSIoMesg *) mesg)->size;
+        stream->numQueued--;
 
-        dest += copySize;
-        srcStart += copySize;
-        size -= copySize;
+        dma_stream_queue_blocks();
     }
+
+    return stream->landed;
+}
+
+/**
+ * Perform a DMA read from ROM, and block until completion.
+ */
+void dma_read(u8 *dest, u8 *srcStart, u8 *srcEnd) {
+    dma_stream_start(dest, srcStart, srcEnd);
+    dma_stream_wait(NULL);
 }
 
 /**
@@ -293,6 +367,274 @@ void *dynamic_dma_read(u8 *srcStart, u8 *srcEnd, u32 side, u32 alignment, u32 bs
     return dest;
 }
 
+/**
+ * Compressed segments start with a 16 byte header: a magic number for the method they were compressed with,
+ * the decompressed size, and then whatever else that method needs. Segments can each use a different method
+ * (see compression/segment_compression.mk), so the method is picked from the magic number.
+ */
+#define SEGMENT_MAGIC_MIO0 0x4D494F30 // "MIO0"
+#define SEGMENT_MAGIC_YAY0 0x59617930 // "Yay0"
+#define SEGMENT_MAGIC_GZIP 0x475A4950 // "GZIP"
+#define SEGMENT_MAGIC_RNC1 0x524E4301 // "RNC" 1
+#define SEGMENT_MAGIC_RNC2 0x524E4302 // "RNC" 2
+#define SEGMENT_MAGIC_LZ4  0x4C5A3442 // "LZ4B"
+
+#if defined(YAY0) || defined(GZIP)
+/**
+ * Compressed segments are decoded straight out of small input windows that are refilled by DMA while the
+ * decoder runs, instead of reading the whole segment into a staging buffer first. Each window has two blocks:
+ * one is decoded while the PI reads the next part of the stream into the other.
+ * Before each block is a margin that the unread tail of the other block is copied to when the decoder moves on,
+ * so the decoder always sees its input as one contiguous run. A decoder can't ask for more than the margin at once.
+ */
+#define DMA_WINDOW_BLOCK_SIZE 0x800
+#define DMA_WINDOW_MARGIN     0x40
+#define DMA_WINDOW_SIZE       (2 * (DMA_WINDOW_MARGIN + DMA_WINDOW_BLOCK_SIZE))
+#define NUM_DMA_WINDOWS       3
+
+struct DmaWindow {
+    OSIoMesg ioMesgs[2];
+    u8 *buffer;
+    u8 *src;        // Where the next block will be read from
+    u8 *srcEnd;
+    u32 sizes[2];   // How much of the stream each block holds, or 0 if it isn't being read in
+    u8 pending[2];  // Whether each block is still being read in
+    u8 block;       // The block being decoded
+};
+
+static struct DmaWindow sDmaWindows[NUM_DMA_WINDOWS];
+static OSMesg sDmaWindowMesgBuf[NUM_DMA_WINDOWS * 2];
+static OSMesgQueue sDmaWindowMesgQueue;
+
+static u8 *dma_window_block(struct DmaWindow *window, s32 block) {
+    return (window->buffer + DMA_WINDOW_MARGIN + (block * (DMA_WINDOW_MARGIN + DMA_WINDOW_BLOCK_SIZE)));
+}
+
+/**
+ * Start reading the next part of the stream into a block, if there is any left.
+ */
+static void dma_window_queue(struct DmaWindow *window, s32 block) {
+    u32 size = 0;
+
+    if (window->src < window->srcEnd) {
+        u8 *dest = dma_window_block(window, block);
+        size = (window->srcEnd - window->src);
+        if (size > DMA_WINDOW_BLOCK_SIZE) {
+            size = DMA_WINDOW_BLOCK_SIZE;
+        }
+
+        osInvalDCache(dest, DMA_WINDOW_BLOCK_SIZE);
+        osPiStartDma(&window->ioMesgs[block], OS_MESG_PRI_NORMAL, OS_READ, (uintptr_t) window->src,
+                     dest, ALIGN16(size), &sDmaWindowMesgQueue);
+        window->pending[block] = TRUE;
+        window->src += size;
+    }
+    window->sizes[block] = size;
+}
+
+/**
+ * Block until a block has been read in. Reads for the other windows that land in the meantime are noted.
+ */
+static void dma_window_wait(struct DmaWindow *window, s32 block) {
+    OSMesg mesg;
+
+    while (window->pending[block]) {
+        osRecvMesg(&sDmaWindowMesgQueue, &mesg, OS_MESG_BLOCK);
+        for (s32 i = 0; i < ARRAY_COUNT(sDmaWindows); i++) {
+            for (s32 j = 0; j < 2; j++) {
+                if (mesg == &sDmaWindows[i].ioMesgs[j]) {
+                    sDmaWindows[i].pending[j] = FALSE;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Start streaming srcStart through srcEnd from ROM through a window. Blocks until the first block has been
+ * read in, and sets *next and *end to the part of the stream that can be decoded.
+ */
+static void dma_window_open(struct DmaWindow *window, u8 *buffer, u8 *srcStart, u8 *srcEnd, u8 **next, u8 **end) {
+    // The PI can only read from even ROM addresses, so an odd stream starts one byte into the first block.
+    u32 offset = ((uintptr_t) srcStart & 1);
+
+    window->buffer = buffer;
+    window->src = (srcStart - offset);
+    window->srcEnd = srcEnd;
+    window->block = 0;
+    dma_window_queue(window, 0);
+    dma_window_queue(window, 1);
+    dma_window_wait(window, 0);
+
+    *next = (dma_window_block(window, 0) + offset);
+    *end = (dma_window_block(window, 0) + window->sizes[0]);
+}
+
+/**
+ * Move on to the next block, carrying over whatever is left of the current one from *next to *end.
+ * Returns FALSE if the whole stream has already been handed out.
+ */
+static s32 dma_window_advance(struct DmaWindow *window, u8 **next, u8 **end) {
+    s32 block = (window->block ^ 1);
+    u32 leftover = (*end - *next);
+
+    if (window->sizes[block] == 0) {
+        return FALSE;
+    }
+
+    u8 *start = (dma_window_block(window, block) - leftover);
+    for (u32 i = 0; i < leftover; i++) {
+        start[i] = (*next)[i];
+    }
+    dma_window_wait(window, block);
+
+    *next = start;
+    *end = (dma_window_block(window, block) + window->sizes[block]);
+
+    // Everything that was left of the old block has been copied out, so it can be refilled.
+    dma_window_queue(window, window->block);
+    window->block = block;
+    return TRUE;
+}
+
+/**
+ * Wait for any reads that are still in flight, since the decoder can be done before the end of the stream.
+ */
+static void dma_windows_close(void) {
+    for (s32 i = 0; i < ARRAY_COUNT(sDmaWindows); i++) {
+        dma_window_wait(&sDmaWindows[i], 0);
+        dma_window_wait(&sDmaWindows[i], 1);
+    }
+}
+
+#ifdef YAY0
+/**
+ * Decompress Yay0 data from ROM as it's read in. The control words, links and literals are each read through
+ * their own window. Returns the allocated buffer, or NULL.
+ */
+static void *yay0_load_streamed(u32 *header, u8 *srcStart, u8 *srcEnd) {
+    struct Yay0DecodeState state;
+    u8 *streamStarts[YAY0_STREAM_COUNT + 1] = { (srcStart + 16), (srcStart + header[2]), (srcStart + header[3]), srcEnd };
+    u32 size = header[1];
+
+    u8 *windows = main_pool_alloc((YAY0_STREAM_COUNT * DMA_WINDOW_SIZE), MEMORY_POOL_RIGHT);
+    if (windows == NULL) {
+        return NULL;
+    }
+    u8 *dest = main_pool_alloc(size, MEMORY_POOL_LEFT);
+    if (dest != NULL) {
+        osCreateMesgQueue(&sDmaWindowMesgQueue, sDmaWindowMesgBuf, ARRAY_COUNT(sDmaWindowMesgBuf));
+        for (s32 i = 0; i < YAY0_STREAM_COUNT; i++) {
+            dma_window_open(&sDmaWindows[i], (windows + (i * DMA_WINDOW_SIZE)), streamStarts[i], streamStarts[i + 1],
+                            &state.in[i], &state.inEnd[i]);
+        }
+
+        state.dest = dest;
+        state.destEnd = (dest + size);
+        state.inFinal = 0;
+
+        s32 stream;
+        while ((stream = yay0_decode(&state)) != YAY0_DECODE_DONE) {
+            if (!dma_window_advance(&sDmaWindows[stream], &state.in[stream], &state.inEnd[stream])) {
+                state.inFinal |= (1 << stream);
+            }
+        }
+
+        dma_windows_close();
+    }
+    main_pool_free(windows);
+    return dest;
+}
+#endif
+
+#ifdef GZIP
+/**
+ * Inflate gzip data from ROM as it's read in. The header holds the decompressed size and the size of the
+ * DEFLATE data after it. Returns the allocated buffer, or NULL.
+ */
+static void *gzip_load_streamed(u32 *header, u8 *srcStart) {
+    u8 *next, *end;
+    u32 size = header[1];
+
+    u8 *windows = main_pool_alloc(DMA_WINDOW_SIZE, MEMORY_POOL_RIGHT);
+    if (windows == NULL) {
+        return NULL;
+    }
+    u8 *dest = main_pool_alloc(size, MEMORY_POOL_LEFT);
+    if (dest != NULL) {
+        osCreateMesgQueue(&sDmaWindowMesgQueue, sDmaWindowMesgBuf, ARRAY_COUNT(sDmaWindowMesgBuf));
+        dma_window_open(&sDmaWindows[0], windows, (srcStart + 16), (srcStart + 16 + header[2]), &next, &end);
+
+        if (expand_gzip_stream_start(dest, size) == 0) {
+            do {
+                // Inflate always takes all of the input it's given, so there's never anything to carry over.
+                if (expand_gzip_stream(next, (end - next)) != 0) {
+                    break;
+                }
+                next = end;
+            } while (dma_window_advance(&sDmaWindows[0], &next, &end));
+            expand_gzip_stream_end();
+        }
+
+        dma_windows_close();
+    }
+    main_pool_free(windows);
+    return dest;
+}
+#endif
+#endif
+
+#ifdef LZ4
+/**
+ * Read LZ4 data into the end of a buffer, and decompress it forwards in place as it comes in.
+ * lz4pack sizes the buffer so that the output never overtakes the compressed data. Returns the allocated buffer, or NULL.
+ */
+static void *lz4_load_in_place(u32 *header, u8 *srcStart) {
+    struct Lz4Header *lz4Header = (struct Lz4Header *) header;
+
+    u8 *dest = main_pool_alloc(lz4Header->bufferSize, MEMORY_POOL_LEFT);
+    if (dest != NULL) {
+        u8 *compressed = (dest + lz4Header->bufferSize - lz4Header->fileSize);
+        dma_stream_start(compressed, srcStart, (srcStart + lz4Header->fileSize));
+        lz4_decompress(compressed, dest, lz4Header->size, dma_stream_wait);
+        dma_stream_wait(NULL);
+        // Give back the space that was only needed to hold the compressed data.
+        main_pool_realloc(dest, lz4Header->size);
+    }
+    return dest;
+}
+#endif
+
+#if defined(MIO0) || defined(RNC1) || defined(RNC2)
+/**
+ * Read the whole of the compressed data into a temporary buffer, and decompress it from there.
+ * Returns the allocated buffer, or NULL.
+ */
+static void *load_staged(u32 *header, u8 *srcStart, u8 *srcEnd) {
+    u8 *compressed = main_pool_alloc(ALIGN16(srcEnd - srcStart), MEMORY_POOL_RIGHT);
+    if (compressed == NULL) {
+        return NULL;
+    }
+    dma_read(compressed, srcStart, srcEnd);
+    u8 *dest = main_pool_alloc(header[1], MEMORY_POOL_LEFT);
+    if (dest != NULL) {
+        switch (header[0]) {
+#ifdef RNC1
+            case SEGMENT_MAGIC_RNC1: Propack_UnpackM1(compressed, dest); break;
+#endif
+#ifdef RNC2
+            case SEGMENT_MAGIC_RNC2: Propack_UnpackM2(compressed, dest); break;
+#endif
+#ifdef MIO0
+            case SEGMENT_MAGIC_MIO0: decompress(compressed, dest); break;
+#endif
+        }
+    }
+    main_pool_free(compressed);
+    return dest;
+}
+#endif
+
 #define TLB_PAGE_SIZE 4096 // Blocksize of TLB transfers. Larger values can be faster to transfer, but more wasteful of RAM.
 s32 gTlbEntries = 0;
 u8 gTlbSegments[NUM_TLB_SEGMENTS] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
@@ -375,47 +717,53 @@ void *load_to_fixed_pool_addr(u8 *destAddr, u8 *srcStart, u8 *srcEnd) {
 void *load_segment_decompress(s32 segment, u8 *srcStart, u8 *srcEnd) {
     void *dest = NULL;
 
-#ifdef GZIP
-    u32 compSize = (srcEnd - 4 - srcStart);
-#else
-    u32 compSize = ALIGN16(srcEnd - srcStart);
-#endif
-    u8 *compressed = main_pool_alloc(compSize, MEMORY_POOL_RIGHT);
-#ifdef GZIP
-    // Decompressed size from end of gzip
-    u32 *size = (u32 *) (compressed + compSize);
-#else
-    // Decompressed size from header (This works for non-mio0 because they also have the size in same place)
-    u32 *size = (u32 *) (compressed + 4);
-#endif
-    if (compressed != NULL) {
 #ifdef UNCOMPRESSED
-        dest = main_pool_alloc(compSize, MEMORY_POOL_LEFT);
+    u32 size = ALIGN16(srcEnd - srcStart);
+    dest = main_pool_alloc(size, MEMORY_POOL_LEFT);
+    if (dest != NULL) {
         dma_read(dest, srcStart, srcEnd);
+    }
 #else
-        dma_read(compressed, srcStart, srcEnd);
-        dest = main_pool_alloc(*size, MEMORY_POOL_LEFT);
+    static u32 header[4] ALIGNED16;
+
+    dma_read((u8 *) header, srcStart, (srcStart + sizeof(header)));
+
+    osSyncPrintf("start decompress\n");
+    switch (header[0]) {
+#ifdef YAY0
+        case SEGMENT_MAGIC_YAY0: dest = yay0_load_streamed(header, srcStart, srcEnd); break;
 #endif
-        if (dest != NULL) {
-            osSyncPrintf("start decompress\n");
 #ifdef GZIP
-            expand_gzip(compressed, dest, compSize, (u32)size);
-#elif RNC1
-            Propack_UnpackM1(compressed, dest);
-#elif RNC2
-            Propack_UnpackM2(compressed, dest);
-#elif YAY0
-            slidstart(compressed, dest);
-#elif MIO0
-            decompress(compressed, dest);
+        case SEGMENT_MAGIC_GZIP: dest = gzip_load_streamed(header, srcStart);         break;
 #endif
-            osSyncPrintf("end decompress\n");
-            set_segment_base_addr(segment, dest);
-            main_pool_free(compressed);
-        }
+#ifdef LZ4
+        case SEGMENT_MAGIC_LZ4:  dest = lz4_load_in_place(header, srcStart);          break;
+#endif
+#ifdef MIO0
+        case SEGMENT_MAGIC_MIO0: dest = load_staged(header, srcStart, srcEnd);        break;
+#endif
+#ifdef RNC1
+        case SEGMENT_MAGIC_RNC1: dest = load_staged(header, srcStart, srcEnd);        break;
+#endif
+#ifdef RNC2
+        case SEGMENT_MAGIC_RNC2: dest = load_staged(header, srcStart, srcEnd);        break;
+#endif
+        default:
+            osSyncPrintf("unknown compression method\n");
+            break;
+    }
+    osSyncPrintf("end decompress\n");
+#endif
+    if (dest != NULL) {
+        set_segment_base_addr(segment, dest);
     }
 #ifdef PUPPYPRINT_DEBUG
-    u32 ppSize = ALIGN16((u32)*size) + 16;
+#ifdef UNCOMPRESSED
+    u32 ppSize = size + 16;
+#else
+    // Every compression method keeps the decompressed size in the second word of its header.
+    u32 ppSize = ALIGN16(header[1]) + 16;
+#endif
     set_segment_memory_printout(segment, ppSize);
 #endif
     return dest;
@@ -615,6 +963,161 @@ void setup_dma_table_list(struct DmaHandlerList *list, void *srcAddr, void *buff
     }
     list->currentAddr = NULL;
     list->bufTarget = buffer;
+    list->packed = NULL;
+}
+
+/**
+ * Entries of packed tables are read into a buffer of their own, and then unpacked into the list's buffer.
+ * After an entry is loaded, the entry that was loaded after it the last time is read into the buffer in the
+ * background, so that it's usually there already when it's asked for, and only has to be unpacked.
+ */
+#define PACKED_DMA_MAX_BLOCKS 8
+
+struct PackedDmaState {
+    u8 *buffer;
+    s32 bufferIndex; // The entry that is in the buffer or being read into it, or -1
+    u32 numQueued;   // How many blocks of it are still being read
+    s32 lastIndex;   // The entry that was loaded last, or -1
+    s16 *nextIndex;  // The entry that was loaded after each entry the last time, or -1
+    OSIoMesg ioMesgs[PACKED_DMA_MAX_BLOCKS];
+    OSMesg mesgBuf[PACKED_DMA_MAX_BLOCKS];
+    OSMesgQueue mesgQueue;
+};
+
+/**
+ * Set up a table whose entries were packed by tools/mario_anims_converter.py. See PackedDmaHeader.
+ */
+void setup_packed_dma_table_list(struct DmaHandlerList *list, void *srcAddr, void *buffer) {
+    setup_dma_table_list(list, srcAddr, buffer);
+
+    struct DmaTable *table = list->dmaTable;
+    struct PackedDmaState *packed = main_pool_alloc(sizeof(struct PackedDmaState) + (table->count * sizeof(s16)),
+                                                    MEMORY_POOL_LEFT);
+    u32 bufferSize = 0;
+
+    for (u32 i = 0; i < table->count; i++) {
+        bufferSize = MAX(bufferSize, ALIGN16(table->anim[i].size));
+    }
+    assert(bufferSize <= (PACKED_DMA_MAX_BLOCKS * DMA_STREAM_BLOCK_SIZE), "Packed DMA table entry is too large.");
+
+    packed->buffer = main_pool_alloc(bufferSize, MEMORY_POOL_LEFT);
+    packed->bufferIndex = -1;
+    packed->numQueued = 0;
+    packed->lastIndex = -1;
+    packed->nextIndex = (s16 *) (packed + 1);
+    for (u32 i = 0; i < table->count; i++) {
+        packed->nextIndex[i] = -1;
+    }
+    osCreateMesgQueue(&packed->mesgQueue, packed->mesgBuf, ARRAY_COUNT(packed->mesgBuf));
+    list->packed = packed;
+}
+
+/**
+ * Start reading an entry into the buffer in the background.
+ */
+static void packed_dma_prefetch(struct PackedDmaState *packed, struct DmaTable *table, s32 index) {
+    u8 *src = (table->srcAddr + table->anim[index].offset);
+    u8 *srcEnd = (src + ALIGN16(table->anim[index].size));
+    u8 *dest = packed->buffer;
+
+    osInvalDCache(dest, (srcEnd - src));
+    while (src < srcEnd) {
+        u32 size = MIN((u32) (srcEnd - src), DMA_STREAM_BLOCK_SIZE);
+
+        osPiStartDma(&packed->ioMesgs[packed->numQueued], OS_MESG_PRI_NORMAL, OS_READ, (uintptr_t) src, dest, size,
+                     &packed->mesgQueue);
+        packed->numQueued++;
+        src += size;
+        dest += size;
+    }
+    packed->bufferIndex = index;
+}
+
+/**
+ * Block until the entry being read into the buffer, if any, has landed.
+ */
+static void packed_dma_wait(struct PackedDmaState *packed) {
+    OSMesg mesg;
+
+    while (packed->numQueued != 0) {
+        osRecvMesg(&packed->mesgQueue, &mesg, OS_MESG_BLOCK);
+        packed->numQueued--;
+    }
+}
+
+/**
+ * Unpack values packed by tools/mario_anims_converter.py. They're in blocks, each starting with a u16 header:
+ *   bits 15-7: number of values - 1
+ *   bits 6-2:  0 if the values follow as they are, otherwise the size in bits of each residual
+ *   bits 1-0:  how far to shift the values left once they're unpacked
+ * A block of residuals has its first value, and then the difference between each next value and the one
+ * predicted from the two before it, packed into the given number of bits and padded to a byte.
+ */
+static void unpack_s16_values(s16 *dest, u8 *src, u32 numValues) {
+    s16 *end = (dest + numValues);
+
+    while (dest < end) {
+        u32 header = ((src[0] << 8) | src[1]);
+        u32 count = ((header >> 7) + 1);
+        u32 width = ((header >> 2) & 0x1F);
+        u32 shift = (header & 0x3);
+        src += 2;
+
+        if (width == 0) {
+            for (; count != 0; count--) {
+                *dest++ = ((src[0] << 8) | src[1]);
+                src += 2;
+            }
+        } else {
+            s16 prev = ((src[0] << 8) | src[1]);
+            s16 prev2 = prev;
+            u32 bitBuf = 0;
+            u32 numBits = 0;
+            src += 2;
+            *dest++ = ((u16) prev << shift);
+
+            for (count--; count != 0; count--) {
+                while (numBits < width) {
+                    bitBuf = ((bitBuf << 8) | *src++);
+                    numBits += 8;
+                }
+                numBits -= width;
+                // Move the residual to the top of the word and back down to sign extend it.
+                s32 residual = ((s32) (bitBuf << (32 - width - numBits)) >> (32 - width));
+                s16 value = ((2 * prev) - prev2 + residual);
+                prev2 = prev;
+                prev = value;
+                *dest++ = ((u16) value << shift);
+            }
+        }
+    }
+}
+
+static void load_packed_table_entry(struct DmaHandlerList *list, s32 index) {
+    struct PackedDmaState *packed = list->packed;
+    struct DmaTable *table = list->dmaTable;
+
+    // The buffer can't be used until whatever is being read into it has landed.
+    packed_dma_wait(packed);
+    if (packed->bufferIndex != index) {
+        u8 *addr = (table->srcAddr + table->anim[index].offset);
+        dma_read(packed->buffer, addr, (addr + table->anim[index].size));
+        packed->bufferIndex = index;
+    }
+
+    struct PackedDmaHeader *header = (struct PackedDmaHeader *) packed->buffer;
+    u8 *raw = (packed->buffer + sizeof(struct PackedDmaHeader));
+    bcopy(raw, list->bufTarget, header->rawSize);
+    unpack_s16_values((s16 *) ((u8 *) list->bufTarget + header->rawSize), (raw + header->rawSize), header->numValues);
+
+    // Remember that this entry came after the last one, and start reading the one that came after it last time.
+    if (packed->lastIndex >= 0) {
+        packed->nextIndex[packed->lastIndex] = index;
+    }
+    packed->lastIndex = index;
+    if (packed->nextIndex[index] >= 0) {
+        packed_dma_prefetch(packed, table, packed->nextIndex[index]);
+    }
 }
 
 s32 load_patchable_table(struct DmaHandlerList *list, s32 index) {
@@ -625,7 +1128,11 @@ s32 load_patchable_table(struct DmaHandlerList *list, s32 index) {
         s32 size = table->anim[index].size;
 
         if (list->currentAddr != addr) {
-            dma_read(list->bufTarget, addr, addr + size);
+            if (list->packed != NULL) {
+                load_packed_table_entry(list, index);
+            } else {
+                dma_read(list->bufTarget, addr, addr + size);
+            }
             list->currentAddr = addr;
             return TRUE;
         }
@@ -5,4 +5,31 @@ void slidstart(unsigned char *compress, unsigned char *decompress);
 
 void decompress(void *mio0, void *dest);
 
+/**
+ * The three parts of Yay0 data, which follow each other after the 16 byte header.
+ */
+enum Yay0Streams {
+    YAY0_STREAM_CTRL,  // 32-bit words of control bits, one per token
+    YAY0_STREAM_LINK,  // 16-bit back references
+    YAY0_STREAM_CHUNK, // Literal bytes, and the lengths of long back references
+    YAY0_STREAM_COUNT
+};
+
+#define YAY0_DECODE_DONE -1
+
+// The most that a single control word's tokens can read from each stream.
+#define YAY0_CTRL_NEED  4
+#define YAY0_LINK_NEED  (32 * 2)
+#define YAY0_CHUNK_NEED 32
+
+struct Yay0DecodeState {
+    u8 *dest;
+    u8 *destEnd;
+    u8 *in[YAY0_STREAM_COUNT];    // Next byte to read from each stream
+    u8 *inEnd[YAY0_STREAM_COUNT]; // End of the data available for each stream
+    u8 inFinal;                   // Bit for each stream whose window holds the rest of it
+};
+
+s32 yay0_decode(struct Yay0DecodeState *state);
+
 #endif // SLIDEC_H
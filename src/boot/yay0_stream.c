@@ -0,0 +1,67 @@
+#include <PR/ultratypes.h>
+
+#include "slidec.h"
+
+/**
+ * Resumable Yay0 decoder. This produces the same output as slidstart, but reads the control bits,
+ * links and literals through separate input windows, so the compressed data never has to be in
+ * memory all at once.
+ *
+ * Each control word is only decoded once every window holds as much data as its 32 tokens could
+ * need, or the rest of that stream. Otherwise the decoder returns which stream needs more input,
+ * and can be called again once that window has been refilled.
+ */
+s32 yay0_decode(struct Yay0DecodeState *state) {
+    u8 *dest = state->dest;
+    u8 *destEnd = state->destEnd;
+    u32 *ctrl = (u32 *) state->in[YAY0_STREAM_CTRL];
+    u16 *link = (u16 *) state->in[YAY0_STREAM_LINK];
+    u8 *chunk = state->in[YAY0_STREAM_CHUNK];
+    s32 result = YAY0_DECODE_DONE;
+
+    while (dest < destEnd) {
+        if (((u8 *) ctrl + YAY0_CTRL_NEED) > state->inEnd[YAY0_STREAM_CTRL] && !(state->inFinal & (1 << YAY0_STREAM_CTRL))) {
+            result = YAY0_STREAM_CTRL;
+            break;
+        }
+        if (((u8 *) link + YAY0_LINK_NEED) > state->inEnd[YAY0_STREAM_LINK] && !(state->inFinal & (1 << YAY0_STREAM_LINK))) {
+            result = YAY0_STREAM_LINK;
+            break;
+        }
+        if ((chunk + YAY0_CHUNK_NEED) > state->inEnd[YAY0_STREAM_CHUNK] && !(state->inFinal & (1 << YAY0_STREAM_CHUNK))) {
+            result = YAY0_STREAM_CHUNK;
+            break;
+        }
+
+        u32 bits = *ctrl++;
+        s32 numTokens = 32;
+
+        do {
+            if (bits & 0x80000000) {
+                *dest++ = *chunk++;
+            } else {
+                u32 token = *link++;
+                u8 *from = (dest - (token & 0xFFF) - 1);
+                u32 length = (token >> 12);
+
+                if (length == 0) {
+                    length = (*chunk++ + 18);
+                } else {
+                    length += 2;
+                }
+
+                do {
+                    *dest++ = *from++;
+                } while (--length);
+            }
+            bits <<= 1;
+        } while (--numTokens && dest < destEnd);
+    }
+
+    state->dest = dest;
+    state->in[YAY0_STREAM_CTRL] = (u8 *) ctrl;
+    state->in[YAY0_STREAM_LINK] = (u8 *) link;
+    state->in[YAY0_STREAM_CHUNK] = chunk;
+
+    return result;
+}
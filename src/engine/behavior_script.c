@@ -289,10 +289,17 @@ static s32 bhv_cmd_end_repeat_continue(void) {
     return BHV_PROC_CONTINUE;
 }
 
+#ifdef BEHAVIOR_NATIVE_LOOPS
+static struct BhvNativeLoop *get_behavior_native_loop(const BehaviorScript *head);
+#endif
+
 // Command 0x08: Marks the beginning of an infinite loop.
 // Usage: BEGIN_LOOP()
 static s32 bhv_cmd_begin_loop(void) {
     cur_obj_bhv_stack_push(BHV_CMD_GET_ADDR_OF_CMD(1)); // Store address of the first command of the loop in the stack
+#ifdef BEHAVIOR_NATIVE_LOOPS
+    gCurrentObject->nativeLoop = get_behavior_native_loop(&gCurBhvCommand[1]);
+#endif
 
     gCurBhvCommand++;
     return BHV_PROC_CONTINUE;
@@ -812,6 +819,75 @@ static BhvCommandProc BehaviorCmdTable[] = {
     /*BHV_CMD_SPAWN_WATER_DROPLET   */ bhv_cmd_spawn_water_droplet,
 };
 
+#ifdef BEHAVIOR_NATIVE_LOOPS
+// How many loops can be decoded at once. Must be a power of two.
+#define BHV_NATIVE_LOOP_COUNT      256
+// Loops that call more native functions than this are interpreted.
+#define BHV_NATIVE_LOOP_MAX_FUNCS  4
+
+/**
+ * A loop of only CALL_NATIVE commands, with the function addresses already decoded.
+ * Running the loop calls each of them, then leaves the object at the start of the loop just like END_LOOP.
+ */
+struct BhvNativeLoop {
+    const BehaviorScript *head; // The first command in the loop
+    u32 numFuncs;               // 0 if the loop can't be decoded
+    NativeBhvFunc funcs[BHV_NATIVE_LOOP_MAX_FUNCS];
+};
+
+static struct BhvNativeLoop sBhvNativeLoops[BHV_NATIVE_LOOP_COUNT];
+
+/**
+ * Forget every decoded loop, in case the next level loads different behavior scripts.
+ */
+void clear_behavior_native_loops(void) {
+    bzero(sBhvNativeLoops, sizeof(sBhvNativeLoops));
+}
+
+/**
+ * Decode the loop starting at head, if it only calls native functions.
+ */
+static void decode_behavior_native_loop(struct BhvNativeLoop *loop, const BehaviorScript *head) {
+    const BehaviorScript *cmd = head;
+
+    loop->head = head;
+    loop->numFuncs = 0;
+
+    while (BehaviorCmdTable[*cmd >> 24] == bhv_cmd_call_native) {
+        if (loop->numFuncs == BHV_NATIVE_LOOP_MAX_FUNCS) {
+            loop->numFuncs = 0;
+            return;
+        }
+        loop->funcs[loop->numFuncs++] = (NativeBhvFunc) OS_PHYSICAL_TO_K0(*cmd & 0xFFFFFF);
+        cmd++;
+    }
+
+    if (BehaviorCmdTable[*cmd >> 24] != bhv_cmd_end_loop) {
+        loop->numFuncs = 0;
+    }
+}
+
+/**
+ * Return the decoded loop starting at head, decoding it first if this is the first time it's been run.
+ * Return NULL if the loop doesn't only call native functions, or there's no room left to decode it.
+ */
+static struct BhvNativeLoop *get_behavior_native_loop(const BehaviorScript *head) {
+    u32 slot = ((((uintptr_t) head >> 2) * 2654435761U) >> 16);
+
+    for (u32 i = 0; i < BHV_NATIVE_LOOP_COUNT; i++) {
+        struct BhvNativeLoop *loop = &sBhvNativeLoops[(slot + i) & (BHV_NATIVE_LOOP_COUNT - 1)];
+        if (loop->head == NULL) {
+            decode_behavior_native_loop(loop, head);
+        }
+        if (loop->head == head) {
+            return (loop->numFuncs != 0) ? loop : NULL;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
 // Execute the behavior script of the current object, process the object flags, and other miscellaneous code for updating objects.
 void cur_obj_update(void) {
     u32 objFlags = o->oFlags;
@@ -849,12 +925,23 @@ void cur_obj_update(void) {
     // Execute the behavior script.
     gCurBhvCommand = o->curBhvCommand;
 
-    do {
-        bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
-        bhvProcResult = bhvCmdProc();
-    } while (bhvProcResult == BHV_PROC_CONTINUE);
+#ifdef BEHAVIOR_NATIVE_LOOPS
+    struct BhvNativeLoop *loop = o->nativeLoop;
+    if (loop != NULL && loop->head == gCurBhvCommand) {
+        // The object is at the start of a decoded loop, so just call its functions.
+        for (u32 i = 0; i < loop->numFuncs; i++) {
+            loop->funcs[i]();
+        }
+    } else
+#endif
+    {
+        do {
+            bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
+            bhvProcResult = bhvCmdProc();
+        } while (bhvProcResult == BHV_PROC_CONTINUE);
 
-    o->curBhvCommand = gCurBhvCommand;
+        o->curBhvCommand = gCurBhvCommand;
+    }
 
     // Increment the object's timer.
     if (o->oTimer < 0x3FFFFFFF) {
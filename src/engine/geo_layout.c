@@ -43,6 +43,7 @@ GeoLayoutCommandProc GeoLayoutJumpTable[] = {
     /*GEO_CMD_NOP_1E                    */ geo_layout_cmd_nop2,
     /*GEO_CMD_NOP_1F                    */ geo_layout_cmd_nop3,
     /*GEO_CMD_NODE_CULLING_RADIUS       */ geo_layout_cmd_node_culling_radius,
+    /*GEO_CMD_NODE_CULLING_BOX          */ geo_layout_cmd_node_culling_box,
 };
 
 struct GraphNode gObjParentGraphNode;
@@ -751,6 +752,25 @@ void geo_layout_cmd_node_culling_radius(void) {
     gGeoLayoutCommand += 0x04 << CMD_SIZE_SHIFT;
 }
 
+/*
+  0x21: Create a scene graph node that only draws its children if a box around them is in view.
+   cmd+0x04: s16 minX, minY, minZ
+   cmd+0x0A: s16 maxX, maxY, maxZ
+*/
+void geo_layout_cmd_node_culling_box(void) {
+    struct GraphNodeCullingBox *graphNode;
+    Vec3s min, max;
+
+    vec3s_set(min, cur_geo_cmd_s16(0x04), cur_geo_cmd_s16(0x06), cur_geo_cmd_s16(0x08));
+    vec3s_set(max, cur_geo_cmd_s16(0x0A), cur_geo_cmd_s16(0x0C), cur_geo_cmd_s16(0x0E));
+
+    graphNode = init_graph_node_culling_box(gGraphNodePool, NULL, min, max);
+
+    register_scene_graph_node(&graphNode->node);
+
+    gGeoLayoutCommand += 0x10 << CMD_SIZE_SHIFT;
+}
+
 struct GraphNode *process_geo_layout(struct AllocOnlyPool *pool, void *segptr) {
     // set by register_scene_graph_node when gCurGraphNodeIndex is 0
     // and gCurRootGraphNode is NULL
@@ -334,6 +334,25 @@ struct GraphNodeCullingRadius *init_graph_node_culling_radius(struct AllocOnlyPo
     return graphNode;
 }
 
+/**
+ * Allocates and returns a newly created frustum culling box node
+ */
+struct GraphNodeCullingBox *init_graph_node_culling_box(struct AllocOnlyPool *pool,
+                                                        struct GraphNodeCullingBox *graphNode,
+                                                        Vec3s min, Vec3s max) {
+    if (pool != NULL) {
+        graphNode = alloc_only_pool_alloc(pool, sizeof(struct GraphNodeCullingBox));
+    }
+
+    if (graphNode != NULL) {
+        init_scene_graph_node_links(&graphNode->node, GRAPH_NODE_TYPE_CULLING_BOX);
+        vec3s_copy(graphNode->min, min);
+        vec3s_copy(graphNode->max, max);
+    }
+
+    return graphNode;
+}
+
 /**
  * Allocates and returns a newly created animated part node
  */
@@ -65,6 +65,7 @@ enum GraphNodeTypes {
     GRAPH_NODE_TYPE_CULLING_RADIUS,
     GRAPH_NODE_TYPE_ROOT,
     GRAPH_NODE_TYPE_START,
+    GRAPH_NODE_TYPE_CULLING_BOX,
 };
 
 // Passed as first argument to a GraphNodeFunc to give information about in
@@ -138,6 +139,10 @@ struct DisplayListNode {
     Mtx *transform;
     void *displayList;
     struct DisplayListNode *next;
+#ifdef SORT_DISPLAY_LISTS
+    u32 sortKey; // Texture in the upper 16 bits, depth in the lower 16.
+    struct GraphNodeObject *sortGroup; // The object the display list belongs to, which is sorted as a whole.
+#endif
 };
 
 /** GraphNode that manages the 8 top-level display lists that will be drawn
@@ -347,6 +352,15 @@ struct GraphNodeCullingRadius {
     // u8 filler[2];
 };
 
+/** GraphNode that skips its children when a box around them is out of view.
+ *  Boxes can be nested, so large areas are rejected without testing each chunk in them.
+ */
+struct GraphNodeCullingBox {
+    /*0x00*/ struct GraphNode node;
+    /*0x14*/ Vec3s min;
+    /*0x1A*/ Vec3s max;
+};
+
 extern struct GraphNodeMasterList  *gCurGraphNodeMasterList;
 extern struct GraphNodePerspective *gCurGraphNodeCamFrustum;
 extern struct GraphNodeCamera      *gCurGraphNodeCamera;
@@ -375,6 +389,7 @@ struct GraphNodeRotation            *init_graph_node_rotation            (struct
 struct GraphNodeScale               *init_graph_node_scale               (struct AllocOnlyPool *pool, struct GraphNodeScale               *graphNode, s32 drawingLayer, void *displayList, f32 scale);
 struct GraphNodeObject              *init_graph_node_object              (struct AllocOnlyPool *pool, struct GraphNodeObject              *graphNode, struct GraphNode *sharedChild, Vec3f pos, Vec3s angle, Vec3f scale);
 struct GraphNodeCullingRadius       *init_graph_node_culling_radius      (struct AllocOnlyPool *pool, struct GraphNodeCullingRadius       *graphNode, s16 radius);
+struct GraphNodeCullingBox          *init_graph_node_culling_box         (struct AllocOnlyPool *pool, struct GraphNodeCullingBox          *graphNode, Vec3s min, Vec3s max);
 struct GraphNodeAnimatedPart        *init_graph_node_animated_part       (struct AllocOnlyPool *pool, struct GraphNodeAnimatedPart        *graphNode, s32 drawingLayer, void *displayList, Vec3s translation);
 struct GraphNodeBillboard           *init_graph_node_billboard           (struct AllocOnlyPool *pool, struct GraphNodeBillboard           *graphNode, s32 drawingLayer, void *displayList, Vec3s translation);
 struct GraphNodeDisplayList         *init_graph_node_display_list        (struct AllocOnlyPool *pool, struct GraphNodeDisplayList         *graphNode, s32 drawingLayer, void *displayList);
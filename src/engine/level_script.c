@@ -29,6 +29,7 @@
 #include "string.h"
 #include "game/puppycam2.h"
 #include "game/puppyprint.h"
+#include "game/rendering_graph_node.h"
 #include "game/emutest.h"
 
 #include "config.h"
@@ -376,6 +377,10 @@ static void level_cmd_alloc_level_pool(void) {
     if (sLevelPool == NULL) {
         sLevelPool = alloc_only_pool_init(main_pool_available() - sizeof(struct AllocOnlyPool),
                                           MEMORY_POOL_LEFT);
+#ifdef MATRIX_CACHE_SIZE
+        // The graph nodes from the last level are gone.
+        reset_matrix_caches();
+#endif
     }
 
     sCurrentCmd = CMD_NEXT;
@@ -871,6 +876,11 @@ static void level_cmd_set_echo(void) {
     sCurrentCmd = CMD_NEXT;
 }
 
+static void level_cmd_reserve_objects(void) {
+    reserve_objects(CMD_GET(s16, 2));
+    sCurrentCmd = CMD_NEXT;
+}
+
 static void (*LevelScriptJumpTable[])(void) = {
     /*LEVEL_CMD_LOAD_AND_EXECUTE            */ level_cmd_load_and_execute,
     /*LEVEL_CMD_EXIT_AND_EXECUTE            */ level_cmd_exit_and_execute,
@@ -936,6 +946,7 @@ static void (*LevelScriptJumpTable[])(void) = {
     /*LEVEL_CMD_PUPPYVOLUME                 */ level_cmd_puppyvolume,
     /*LEVEL_CMD_CHANGE_AREA_SKYBOX          */ level_cmd_change_area_skybox,
     /*LEVEL_CMD_SET_ECHO                    */ level_cmd_set_echo,
+    /*LEVEL_CMD_RESERVE_OBJECTS             */ level_cmd_reserve_objects,
 };
 
 struct LevelCommand *level_script_execute(struct LevelCommand *cmd) {
@@ -916,23 +916,73 @@ void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f
     profiler_collision_update(first);
 }
 
+#ifdef FLAT_STATIC_PARTITION
+/**
+ * Same as find_surface_on_ray_list, for a cell of the flattened static partition.
+ */
+void find_surface_on_ray_array(struct Surface **array, Vec3f orig, Vec3f dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length) {
+    s32 hit;
+    f32 length;
+    Vec3f chk_hit_pos;
+    f32 top, bottom;
+    struct Surface *surf;
+    PUPPYPRINT_GET_SNAPSHOT();
+    // Get upper and lower bounds of ray
+    if (dir[1] >= 0.0f) {
+        // Ray is upwards.
+        top    = orig[1] + (dir[1] * dir_length);
+        bottom = orig[1];
+    } else {
+        // Ray is downwards.
+        top    = orig[1];
+        bottom = orig[1] + (dir[1] * dir_length);
+    }
+
+    // Iterate through every surface of the array
+    for (surf = array[0]; surf < array[1]; surf++) {
+        // Reject surface if out of vertical bounds
+        if ((surf->lowerY > top) || (surf->upperY < bottom)) continue;
+        // Check intersection between the ray and this surface
+        hit = ray_surface_intersect(orig, dir, dir_length, surf, chk_hit_pos, &length);
+        if (hit && (length <= *max_length)) {
+            *hit_surface = STATIC_SURFACE_ORIGIN(surf);
+            vec3f_copy(hit_pos, chk_hit_pos);
+            *max_length = length;
+        }
+    }
+    profiler_collision_update(first);
+}
+#endif
+
 void find_surface_on_ray_cell(s32 cellX, s32 cellZ, Vec3f orig, Vec3f normalized_dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags) {
     // Skip if OOB
     if ((cellX >= 0) && (cellX <= (NUM_CELLS - 1)) && (cellZ >= 0) && (cellZ <= (NUM_CELLS - 1))) {
         // Iterate through each surface in this partition
         if ((normalized_dir[1] > -NEAR_ONE) && (flags & RAYCAST_FIND_CEIL)) {
+#ifdef FLAT_STATIC_PARTITION
+            find_surface_on_ray_array(STATIC_SURFACE_ARRAY(cellZ, cellX, SPATIAL_PARTITION_CEILS ), orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+#endif
             find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
             find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if ((normalized_dir[1] <  NEAR_ONE) && (flags & RAYCAST_FIND_FLOOR)) {
+#ifdef FLAT_STATIC_PARTITION
+            find_surface_on_ray_array(STATIC_SURFACE_ARRAY(cellZ, cellX, SPATIAL_PARTITION_FLOORS), orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+#endif
             find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
             find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if (flags & RAYCAST_FIND_WALL) {
+#ifdef FLAT_STATIC_PARTITION
+            find_surface_on_ray_array(STATIC_SURFACE_ARRAY(cellZ, cellX, SPATIAL_PARTITION_WALLS ), orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+#endif
             find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
             find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if (flags & RAYCAST_FIND_WATER) {
+#ifdef FLAT_STATIC_PARTITION
+            find_surface_on_ray_array(STATIC_SURFACE_ARRAY(cellZ, cellX, SPATIAL_PARTITION_WATER ), orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+#endif
             find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
             find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
@@ -1004,6 +1054,9 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
 // Especially fast for halfword floats, which get loaded with a `lui` + `mtc1`.
 static ALWAYS_INLINE float construct_float(const float f)
 {
+#ifndef TARGET_N64
+    return f;
+#else
     u32 r;
     float f_out;
     u32 i = *(u32*)(&f);
@@ -1037,6 +1090,7 @@ static ALWAYS_INLINE float construct_float(const float f)
                          : "=f"(f_out)
                          : "r"(r));
     return f_out;
+#endif
 }
 
 // Converts a floating point matrix to a fixed point matrix
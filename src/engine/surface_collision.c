@@ -46,21 +46,109 @@ s32 check_wall_edge(Vec3f vert, Vec3f v2, f32 *d00, f32 *d01, f32 *invDenom, f32
     return TRUE;
 }
 
+/**
+ * Check a wall against pos, and push pos out of the wall if they collide.
+ */
+static ALWAYS_INLINE s32 check_wall_collision(struct Surface *surf, Vec3f pos, f32 radius, f32 *margin_radius) {
+    const f32 corner_threshold = -0.9f;
+    f32 offset;
+    Vec3f v0, v1, v2;
+    f32 d00, d01, d11, d20, d21;
+    f32 invDenom;
+    TerrainData type = surf->type;
+
+    // Exclude a large number of walls immediately to optimize.
+    if (pos[1] < surf->lowerY || pos[1] > surf->upperY) return FALSE;
+
+    // Determine if checking for the camera or not.
+    if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
+        if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) return FALSE;
+    } else {
+        // Ignore camera only surfaces.
+        if (type == SURFACE_CAMERA_BOUNDARY) return FALSE;
+
+        // If an object can pass through a vanish cap wall, pass through.
+        if (type == SURFACE_VANISH_CAP_WALLS && o != NULL) {
+            // If an object can pass through a vanish cap wall, pass through.
+            if (o->activeFlags & ACTIVE_FLAG_MOVE_THROUGH_GRATE) return FALSE;
+            // If Mario has a vanish cap, pass through the vanish cap wall.
+            if (o == gMarioObject && gMarioState->flags & MARIO_VANISH_CAP) return FALSE;
+        }
+    }
+
+    // Dot of normal and pos, + origin offset
+    offset = (surf->normal.x * pos[0])
+           + (surf->normal.y * pos[1])
+           + (surf->normal.z * pos[2])
+           + surf->originOffset;
+
+    // Exclude surfaces outside of the radius.
+    if (offset < -radius || offset > radius) return FALSE;
+
+    vec3_diff(v0, surf->vertex2, surf->vertex1);
+    vec3_diff(v1, surf->vertex3, surf->vertex1);
+    vec3_diff(v2, pos,           surf->vertex1);
+
+    // Face
+    d00 = vec3_dot(v0, v0);
+    d01 = vec3_dot(v0, v1);
+    d11 = vec3_dot(v1, v1);
+    d20 = vec3_dot(v2, v0);
+    d21 = vec3_dot(v2, v1);
+
+    invDenom = (d00 * d11) - (d01 * d01);
+    if (FLT_IS_NONZERO(invDenom)) {
+        invDenom = 1.0f / invDenom;
+    }
+
+    if (check_wall_vw(d00, d01, d11, d20, d21, invDenom)) {
+        if (offset < 0) {
+            return FALSE;
+        }
+
+        // Edge 1-2
+        if (check_wall_edge(v0, v2, &d00, &d01, &invDenom, &offset, *margin_radius)) {
+            // Edge 1-3
+            if (check_wall_edge(v1, v2, &d00, &d01, &invDenom, &offset, *margin_radius)) {
+                vec3_diff(v1, surf->vertex3, surf->vertex2);
+                vec3_diff(v2, pos, surf->vertex2);
+                // Edge 2-3
+                if (check_wall_edge(v1, v2, &d00, &d01, &invDenom, &offset, *margin_radius)) {
+                    return FALSE;
+                }
+            }
+        }
+
+        // Check collision
+        if (FLT_IS_NONZERO(invDenom)) {
+            invDenom = (offset / invDenom);
+        }
+
+        // Update pos
+        pos[0] += (d00 *= invDenom);
+        pos[2] += (d01 *= invDenom);
+        *margin_radius += 0.01f;
+
+        if ((d00 * surf->normal.x) + (d01 * surf->normal.z) < (corner_threshold * offset)) {
+            return FALSE;
+        }
+    } else {
+        // Update pos
+        pos[0] += surf->normal.x * (radius - offset);
+        pos[2] += surf->normal.z * (radius - offset);
+    }
+
+    return TRUE;
+}
+
 /**
  * Iterate through the list of walls until all walls are checked and
  * have given their wall push.
  */
 static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struct WallCollisionData *data) {
-    const f32 corner_threshold = -0.9f;
     struct Surface *surf;
-    f32 offset;
     f32 radius = data->radius;
-
     Vec3f pos = { data->x, data->y + data->offsetY, data->z };
-    Vec3f v0, v1, v2;
-    f32 d00, d01, d11, d20, d21;
-    f32 invDenom;
-    TerrainData type = SURFACE_DEFAULT;
     s32 numCols = 0;
 
     f32 margin_radius = radius - 1.0f;
@@ -69,92 +157,93 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struc
     while (surfaceNode != NULL) {
         surf        = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
-        type        = surf->type;
 
-        // Exclude a large number of walls immediately to optimize.
-        if (pos[1] < surf->lowerY || pos[1] > surf->upperY) continue;
+        if (!check_wall_collision(surf, pos, radius, &margin_radius)) continue;
 
-        // Determine if checking for the camera or not.
-        if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
-            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) continue;
-        } else {
-            // Ignore camera only surfaces.
-            if (type == SURFACE_CAMERA_BOUNDARY) continue;
+        // Has collision
+        if (data->numWalls < MAX_REFERENCED_WALLS) {
+            data->walls[data->numWalls++] = surf;
+        }
+        numCols++;
 
-            // If an object can pass through a vanish cap wall, pass through.
-            if (type == SURFACE_VANISH_CAP_WALLS && o != NULL) {
-                // If an object can pass through a vanish cap wall, pass through.
-                if (o->activeFlags & ACTIVE_FLAG_MOVE_THROUGH_GRATE) continue;
-                // If Mario has a vanish cap, pass through the vanish cap wall.
-                if (o == gMarioObject && gMarioState->flags & MARIO_VANISH_CAP) continue;
-            }
+        if (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST) {
+            break;
         }
+    }
+
+    data->x = pos[0];
+    data->z = pos[2];
+    return numCols;
+}
 
-        // Dot of normal and pos, + origin offset
-        offset = (surf->normal.x * pos[0])
-               + (surf->normal.y * pos[1])
-               + (surf->normal.z * pos[2])
-               + surf->originOffset;
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+/**
+ * Get a Y bucket of a static cell, as indices into the cell's array.
+ */
+static ALWAYS_INLINE u16 *get_static_y_bucket(struct StaticSurfaceYIndex *yIndex, s32 bucket, u16 **end) {
+    u16 *indices = (yIndex->bucketStarts + yIndex->numBuckets + 1);
+
+    *end = (indices + yIndex->bucketStarts[bucket + 1]);
+    return (indices + yIndex->bucketStarts[bucket]);
+}
+#endif
+
+#ifdef FLAT_STATIC_PARTITION
+/**
+ * Same as find_wall_collisions_from_list, for a cell of the flattened static partition.
+ */
+static s32 find_wall_collisions_from_array(struct Surface **array, struct WallCollisionData *data) {
+    struct Surface *surf = array[0];
+    struct Surface *end = array[1];
+    f32 radius = data->radius;
+    Vec3f pos = { data->x, data->y + data->offsetY, data->z };
+    s32 numCols = 0;
 
-        // Exclude surfaces outside of the radius.
-        if (offset < -radius || offset > radius) continue;
+    f32 margin_radius = radius - 1.0f;
 
-        vec3_diff(v0, surf->vertex2, surf->vertex1);
-        vec3_diff(v1, surf->vertex3, surf->vertex1);
-        vec3_diff(v2, pos,           surf->vertex1);
+    if (surf == end) return 0;
 
-        // Face
-        d00 = vec3_dot(v0, v0);
-        d01 = vec3_dot(v0, v1);
-        d11 = vec3_dot(v1, v1);
-        d20 = vec3_dot(v2, v0);
-        d21 = vec3_dot(v2, v1);
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+    struct StaticSurfaceYIndex *yIndex = STATIC_SURFACE_Y_INDEX(array);
 
-        invDenom = (d00 * d11) - (d01 * d01);
-        if (FLT_IS_NONZERO(invDenom)) {
-            invDenom = 1.0f / invDenom;
-        }
+    // Only walls in the bucket of the point's height can push it.
+    if (yIndex->numBuckets != 0) {
+        if (pos[1] < yIndex->minY) return 0;
 
-        if (check_wall_vw(d00, d01, d11, d20, d21, invDenom)) {
-            if (offset < 0) {
-                continue;
-            }
+        s32 bucket = ((s32)(pos[1] - yIndex->minY) / STATIC_PARTITION_Y_BUCKET_SIZE);
+        if (bucket >= yIndex->numBuckets) return 0;
 
-            // Edge 1-2
-            if (check_wall_edge(v0, v2, &d00, &d01, &invDenom, &offset, margin_radius)) {
-                // Edge 1-3
-                if (check_wall_edge(v1, v2, &d00, &d01, &invDenom, &offset, margin_radius)) {
-                    vec3_diff(v1, surf->vertex3, surf->vertex2);
-                    vec3_diff(v2, pos, surf->vertex2);
-                    // Edge 2-3
-                    if (check_wall_edge(v1, v2, &d00, &d01, &invDenom, &offset, margin_radius)) {
-                        continue;
-                    }
-                }
-            }
+        u16 *indexEnd;
+        u16 *index = get_static_y_bucket(yIndex, bucket, &indexEnd);
 
-            // Check collision
-            if (FLT_IS_NONZERO(invDenom)) {
-                invDenom = (offset / invDenom);
-            }
+        for (; index < indexEnd; index++) {
+            surf = &array[0][*index];
 
-            // Update pos
-            pos[0] += (d00 *= invDenom);
-            pos[2] += (d01 *= invDenom);
-            margin_radius += 0.01f;
+            if (!check_wall_collision(surf, pos, radius, &margin_radius)) continue;
 
-            if ((d00 * surf->normal.x) + (d01 * surf->normal.z) < (corner_threshold * offset)) {
-                continue;
+            // Has collision
+            if (data->numWalls < MAX_REFERENCED_WALLS) {
+                data->walls[data->numWalls++] = STATIC_SURFACE_ORIGIN(surf);
+            }
+            numCols++;
+
+            if (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST) {
+                break;
             }
-        } else {
-            // Update pos
-            pos[0] += surf->normal.x * (radius - offset);
-            pos[2] += surf->normal.z * (radius - offset);
         }
 
+        data->x = pos[0];
+        data->z = pos[2];
+        return numCols;
+    }
+#endif
+
+    for (; surf < end; surf++) {
+        if (!check_wall_collision(surf, pos, radius, &margin_radius)) continue;
+
         // Has collision
         if (data->numWalls < MAX_REFERENCED_WALLS) {
-            data->walls[data->numWalls++] = surf;
+            data->walls[data->numWalls++] = STATIC_SURFACE_ORIGIN(surf);
         }
         numCols++;
 
@@ -167,6 +256,7 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struc
     data->z = pos[2];
     return numCols;
 }
+#endif
 
 /**
  * Formats the position and wall search for find_wall_collisions.
@@ -225,6 +315,10 @@ s32 find_wall_collisions(struct WallCollisionData *colData) {
             }
 
             // Check for surfaces that are a part of level geometry.
+#ifdef FLAT_STATIC_PARTITION
+            struct Surface **staticArray = STATIC_SURFACE_ARRAY(cellZ, cellX, SPATIAL_PARTITION_WALLS);
+            numCollisions += find_wall_collisions_from_array(staticArray, colData);
+#endif
             node = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS];
             numCollisions += find_wall_collisions_from_list(node, colData);
         }
@@ -295,38 +389,122 @@ static s32 check_within_ceil_triangle_bounds(s32 x, s32 z, struct Surface *surf,
     return TRUE;
 }
 
+/**
+ * Check whether a ceiling is over a given point, and if so get its height there.
+ */
+static ALWAYS_INLINE s32 get_ceil_height_above(struct Surface *surf, s32 x, s32 y, s32 z, f32 *height) {
+    SurfaceType type = surf->type;
+
+    // Exclude all ceilings below the point
+    if (y > surf->upperY) return FALSE;
+
+    // Determine if checking for the camera or not
+    if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
+        if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
+            return FALSE;
+        }
+    } else if (type == SURFACE_CAMERA_BOUNDARY) {
+        // Ignore camera only surfaces
+        return FALSE;
+    }
+
+    // Check that the point is within the triangle bounds
+    if (!check_within_ceil_triangle_bounds(x, z, surf, 1.5f)) return FALSE;
+
+    // Find the height of the ceil at the given location
+    *height = get_surface_height_at_location(x, z, surf);
+    return TRUE;
+}
+
 /**
  * Iterate through the list of ceilings and find the first ceiling over a given point.
  */
 static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 y, s32 z, f32 *pheight) {
     register struct Surface *surf, *ceil = NULL;
-    register f32 height;
-    SurfaceType type = SURFACE_DEFAULT;
+    f32 height;
     *pheight = CELL_HEIGHT_LIMIT;
     // Stay in this loop until out of ceilings.
     while (surfaceNode != NULL) {
         surf = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
-        type = surf->type;
 
-        // Exclude all ceilings below the point
-        if (y > surf->upperY) continue;
+        if (!get_ceil_height_above(surf, x, y, z, &height)) continue;
+
+        // Exclude ceilings above the previous lowest ceiling
+        if (height > *pheight) continue;
+
+        // Checks for ceiling interaction
+        if (y > height) continue;
+
+        // Use the current ceiling
+        *pheight = height;
+        ceil = surf;
 
-        // Determine if checking for the camera or not
-        if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
-            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
-                continue;
+        // Exit the loop if it's not possible for another ceiling to be closer
+        // to the original point, or if COLLISION_FLAG_RETURN_FIRST.
+        if (height == y || (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) break;
+    }
+    return ceil;
+}
+
+#ifdef FLAT_STATIC_PARTITION
+/**
+ * Same as find_ceil_from_list, for a cell of the flattened static partition.
+ */
+static struct Surface *find_ceil_from_array(struct Surface **array, s32 x, s32 y, s32 z, f32 *pheight) {
+    struct Surface *surf = array[0];
+    struct Surface *end = array[1];
+    struct Surface *ceil = NULL;
+    f32 height;
+    *pheight = CELL_HEIGHT_LIMIT;
+
+    if (surf == end) return NULL;
+
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+    struct StaticSurfaceYIndex *yIndex = STATIC_SURFACE_Y_INDEX(array);
+
+    // Walk up through the buckets from the point, until the ceiling found is below the next bucket.
+    if (yIndex->numBuckets != 0) {
+        s32 bucket = MAX(0, ((y - yIndex->minY) / STATIC_PARTITION_Y_BUCKET_SIZE));
+
+        for (; bucket < yIndex->numBuckets; bucket++) {
+            if (*pheight <= (yIndex->minY + (bucket * STATIC_PARTITION_Y_BUCKET_SIZE))) break;
+
+            u16 *indexEnd;
+            u16 *index = get_static_y_bucket(yIndex, bucket, &indexEnd);
+
+            for (; index < indexEnd; index++) {
+                surf = &array[0][*index];
+
+                if (!get_ceil_height_above(surf, x, y, z, &height)) continue;
+
+                // Exclude ceilings above the previous lowest ceiling
+                if (height > *pheight) continue;
+
+                // Surfaces that span several buckets can be visited more than once, so settle ties the
+                // same way walking the whole cell would: the last one in the cell wins, unless the ceiling
+                // is right at the point, where the walk stops at the first one.
+                if (height == *pheight && ceil != NULL && ((height == y) ? (surf > ceil) : (surf < ceil))) continue;
+
+                // Checks for ceiling interaction
+                if (y > height) continue;
+
+                // Use the current ceiling
+                *pheight = height;
+                ceil = surf;
+
+                if (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST) break;
             }
-        } else if (type == SURFACE_CAMERA_BOUNDARY) {
-            // Ignore camera only surfaces
-            continue;
+
+            if (ceil != NULL && (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) break;
         }
 
-        // Check that the point is within the triangle bounds
-        if (!check_within_ceil_triangle_bounds(x, z, surf, 1.5f)) continue;
+        return (ceil != NULL) ? STATIC_SURFACE_ORIGIN(ceil) : NULL;
+    }
+#endif
 
-        // Find the height of the ceil at the given location
-        height = get_surface_height_at_location(x, z, surf);
+    for (; surf < end; surf++) {
+        if (!get_ceil_height_above(surf, x, y, z, &height)) continue;
 
         // Exclude ceilings above the previous lowest ceiling
         if (height > *pheight) continue;
@@ -334,7 +512,6 @@ static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, s32
         // Checks for ceiling interaction
         if (y > height) continue;
 
-
         // Use the current ceiling
         *pheight = height;
         ceil = surf;
@@ -343,8 +520,10 @@ static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, s32
         // to the original point, or if COLLISION_FLAG_RETURN_FIRST.
         if (height == y || (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) break;
     }
-    return ceil;
+
+    return (ceil != NULL) ? STATIC_SURFACE_ORIGIN(ceil) : NULL;
 }
+#endif
 
 /**
  * Find the lowest ceiling above a given position and return the height.
@@ -384,8 +563,25 @@ f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
     }
 
     // Check for surfaces that are a part of level geometry.
+#ifdef FLAT_STATIC_PARTITION
+    struct Surface **staticArray = STATIC_SURFACE_ARRAY(cellZ, cellX, SPATIAL_PARTITION_CEILS);
+    ceil = find_ceil_from_array(staticArray, x, y, z, &height);
+
+    // Static surfaces loaded after the area itself are still kept in lists.
+    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS];
+    if (surfaceList != NULL) {
+        f32 lateHeight;
+        struct Surface *lateCeil = find_ceil_from_list(surfaceList, x, y, z, &lateHeight);
+
+        if (lateCeil != NULL && lateHeight < height) {
+            ceil   = lateCeil;
+            height = lateHeight;
+        }
+    }
+#else
     surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS];
     ceil = find_ceil_from_list(surfaceList, x, y, z, &height);
+#endif
 
     // Use the lower ceiling.
     if (includeDynamic && height >= dynamicHeight) {
@@ -428,44 +624,126 @@ static s32 check_within_floor_triangle_bounds(s32 x, s32 z, struct Surface *surf
     return TRUE;
 }
 
+/**
+ * Check whether a floor is under a given point, and if so get its height there.
+ */
+static ALWAYS_INLINE s32 get_floor_height_below(struct Surface *surf, s32 x, s32 bufferY, s32 z, f32 *height) {
+    SurfaceType type = surf->type;
+
+    // To prevent the Merry-Go-Round room from loading when Mario passes above the hole that leads
+    // there, SURFACE_INTANGIBLE is used. This prevent the wrong room from loading, but can also allow
+    // Mario to pass through.
+    if (!(gCollisionFlags & COLLISION_FLAG_INCLUDE_INTANGIBLE) && (type == SURFACE_INTANGIBLE)) {
+        return FALSE;
+    }
+
+    // Determine if we are checking for the camera or not.
+    if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
+        if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
+            return FALSE;
+        }
+    } else if (type == SURFACE_CAMERA_BOUNDARY) {
+        return FALSE; // If we are not checking for the camera, ignore camera only floors.
+    }
+
+    // Exclude all floors above the point.
+    if (bufferY < surf->lowerY) return FALSE;
+    // Check that the point is within the triangle bounds.
+    if (!check_within_floor_triangle_bounds(x, z, surf)) return FALSE;
+
+    // Get the height of the floor under the current location.
+    *height = get_surface_height_at_location(x, z, surf);
+    return TRUE;
+}
+
 /**
  * Iterate through the list of floors and find the first floor under a given point.
  */
 static struct Surface *find_floor_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 y, s32 z, f32 *pheight) {
     register struct Surface *surf, *floor = NULL;
-    register SurfaceType type = SURFACE_DEFAULT;
-    register f32 height;
+    f32 height;
     register s32 bufferY = y + FIND_FLOOR_BUFFER;
 
     // Iterate through the list of floors until there are no more floors.
     while (surfaceNode != NULL) {
         surf = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
-        type        = surf->type;
 
-        // To prevent the Merry-Go-Round room from loading when Mario passes above the hole that leads
-        // there, SURFACE_INTANGIBLE is used. This prevent the wrong room from loading, but can also allow
-        // Mario to pass through.
-        if (!(gCollisionFlags & COLLISION_FLAG_INCLUDE_INTANGIBLE) && (type == SURFACE_INTANGIBLE)) {
-            continue;
-        }
+        if (!get_floor_height_below(surf, x, bufferY, z, &height)) continue;
+
+        // Exclude floors lower than the previous highest floor.
+        if (height <= *pheight) continue;
+
+        // Checks for floor interaction with a FIND_FLOOR_BUFFER unit buffer.
+        if (bufferY < height) continue;
+
+        // Use the current floor
+        *pheight = height;
+        floor = surf;
+
+        // Exit the loop if it's not possible for another floor to be closer
+        // to the original point, or if COLLISION_FLAG_RETURN_FIRST.
+        if ((height == bufferY) || (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) break;
+    }
+    return floor;
+}
+
+#ifdef FLAT_STATIC_PARTITION
+/**
+ * Same as find_floor_from_list, for a cell of the flattened static partition.
+ */
+static struct Surface *find_floor_from_array(struct Surface **array, s32 x, s32 y, s32 z, f32 *pheight) {
+    struct Surface *surf = array[0];
+    struct Surface *end = array[1];
+    struct Surface *floor = NULL;
+    f32 height;
+    s32 bufferY = y + FIND_FLOOR_BUFFER;
+
+    if (surf == end) return NULL;
+
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+    struct StaticSurfaceYIndex *yIndex = STATIC_SURFACE_Y_INDEX(array);
+
+    // Walk down through the buckets from the point, until the floor found is above the next bucket.
+    if (yIndex->numBuckets != 0) {
+        if (bufferY < yIndex->minY) return NULL;
+
+        s32 bucket = MIN((yIndex->numBuckets - 1), ((bufferY - yIndex->minY) / STATIC_PARTITION_Y_BUCKET_SIZE));
+
+        for (; bucket >= 0; bucket--) {
+            if (*pheight >= (yIndex->minY + ((bucket + 1) * STATIC_PARTITION_Y_BUCKET_SIZE))) break;
+
+            u16 *indexEnd;
+            u16 *index = get_static_y_bucket(yIndex, bucket, &indexEnd);
+
+            for (; index < indexEnd; index++) {
+                surf = &array[0][*index];
+
+                if (!get_floor_height_below(surf, x, bufferY, z, &height)) continue;
+
+                // Surfaces that span several buckets can be visited more than once, so on a tie
+                // keep whichever comes first in the cell, same as when walking the whole cell.
+                if (height < *pheight || (height == *pheight && (floor == NULL || surf >= floor))) continue;
+
+                // Checks for floor interaction with a FIND_FLOOR_BUFFER unit buffer.
+                if (bufferY < height) continue;
 
-        // Determine if we are checking for the camera or not.
-        if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
-            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
-                continue;
+                // Use the current floor
+                *pheight = height;
+                floor = surf;
+
+                if (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST) break;
             }
-        } else if (type == SURFACE_CAMERA_BOUNDARY) {
-            continue; // If we are not checking for the camera, ignore camera only floors.
+
+            if (floor != NULL && (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) break;
         }
 
-        // Exclude all floors above the point.
-        if (bufferY < surf->lowerY) continue;
-        // Check that the point is within the triangle bounds.
-        if (!check_within_floor_triangle_bounds(x, z, surf)) continue;
+        return (floor != NULL) ? STATIC_SURFACE_ORIGIN(floor) : NULL;
+    }
+#endif
 
-        // Get the height of the floor under the current location.
-        height = get_surface_height_at_location(x, z, surf);
+    for (; surf < end; surf++) {
+        if (!get_floor_height_below(surf, x, bufferY, z, &height)) continue;
 
         // Exclude floors lower than the previous highest floor.
         if (height <= *pheight) continue;
@@ -481,8 +759,10 @@ static struct Surface *find_floor_from_list(struct SurfaceNode *surfaceNode, s32
         // to the original point, or if COLLISION_FLAG_RETURN_FIRST.
         if ((height == bufferY) || (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) break;
     }
-    return floor;
+
+    return (floor != NULL) ? STATIC_SURFACE_ORIGIN(floor) : NULL;
 }
+#endif
 
 // Generic triangle bounds func
 ALWAYS_INLINE static s32 check_within_bounds_y_norm(s32 x, s32 z, struct Surface *surf) {
@@ -491,51 +771,130 @@ ALWAYS_INLINE static s32 check_within_bounds_y_norm(s32 x, s32 z, struct Surface
 }
 
 /**
- * Iterate through the list of water floors and find the first water floor under a given point.
+ * Get the height of a water bottom (SURFACE_NEW_WATER_BOTTOM) at a given point, if it's over or under it.
  */
-struct Surface *find_water_floor_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 y, s32 z, f32 *pheight) {
+static ALWAYS_INLINE s32 get_water_bottom_height(struct Surface *surf, s32 x, s32 z, f32 *height) {
+    // skip wall angled water
+    if (surf->type != SURFACE_NEW_WATER_BOTTOM || absf(surf->normal.y) < NORMAL_FLOOR_THRESHOLD) return FALSE;
+
+    if (!check_within_bounds_y_norm(x, z, surf)) return FALSE;
+
+    *height = get_surface_height_at_location(x, z, surf);
+    return TRUE;
+}
+
+/**
+ * Get the height of a water top (SURFACE_NEW_WATER) at a given point, if it's over or under it.
+ */
+static ALWAYS_INLINE s32 get_water_top_height(struct Surface *surf, s32 x, s32 z, f32 *height) {
+    // skip water tops or wall angled water bottoms
+    if (surf->type == SURFACE_NEW_WATER_BOTTOM || absf(surf->normal.y) < NORMAL_FLOOR_THRESHOLD) return FALSE;
+
+    if (!check_within_bounds_y_norm(x, z, surf)) return FALSE;
+
+    *height = get_surface_height_at_location(x, z, surf);
+    return TRUE;
+}
+
+/**
+ * Find the last water bottom in a list that is above a given point.
+ */
+static struct Surface *find_water_bottom_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 y, s32 z, f32 *pheight) {
     register struct Surface *surf;
-    struct Surface *floor = NULL;
-    struct SurfaceNode *topSurfaceNode = surfaceNode;
-    struct SurfaceNode *bottomSurfaceNode = surfaceNode;
-    f32 height = FLOOR_LOWER_LIMIT;
-    f32 curHeight = FLOOR_LOWER_LIMIT;
-    f32 bottomHeight = FLOOR_LOWER_LIMIT;
+    struct Surface *bottom = NULL;
     f32 curBottomHeight = FLOOR_LOWER_LIMIT;
     f32 buffer = FIND_FLOOR_BUFFER;
 
-    // Iterate through the list of water floors until there are no more water floors.
     // SURFACE_NEW_WATER_BOTTOM
-    while (bottomSurfaceNode != NULL) {
-        surf = bottomSurfaceNode->surface;
-        bottomSurfaceNode = bottomSurfaceNode->next;
+    while (surfaceNode != NULL) {
+        surf = surfaceNode->surface;
+        surfaceNode = surfaceNode->next;
 
-        // skip wall angled water
-        if (surf->type != SURFACE_NEW_WATER_BOTTOM || absf(surf->normal.y) < NORMAL_FLOOR_THRESHOLD) continue;
+        if (!get_water_bottom_height(surf, x, z, &curBottomHeight)) continue;
 
-        if (!check_within_bounds_y_norm(x, z, surf)) continue;
+        if (curBottomHeight >= y + buffer) {
+            *pheight = curBottomHeight;
+            bottom = surf;
+        }
+    }
 
-        curBottomHeight = get_surface_height_at_location(x, z, surf);
+    return bottom;
+}
 
-        if (curBottomHeight < y + buffer) {
-            continue;
-        } else {
-            bottomHeight = curBottomHeight;
+/**
+ * Find the highest water top in a list that isn't above the given water bottom.
+ */
+static struct Surface *find_water_top_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 z, f32 bottomHeight, f32 *pheight) {
+    register struct Surface *surf;
+    struct Surface *floor = NULL;
+    f32 height = FLOOR_LOWER_LIMIT;
+    f32 curHeight = FLOOR_LOWER_LIMIT;
+
+    // SURFACE_NEW_WATER
+    while (surfaceNode != NULL) {
+        surf = surfaceNode->surface;
+        surfaceNode = surfaceNode->next;
+
+        if (!get_water_top_height(surf, x, z, &curHeight)) continue;
+
+        if (bottomHeight != FLOOR_LOWER_LIMIT && curHeight > bottomHeight) continue;
+
+        if (curHeight > height) {
+            height = curHeight;
+            *pheight = curHeight;
+            floor = surf;
         }
     }
 
-    // Iterate through the list of water tops until there are no more water tops.
-    // SURFACE_NEW_WATER
-    while (topSurfaceNode != NULL) {
-        surf = topSurfaceNode->surface;
-        topSurfaceNode = topSurfaceNode->next;
+    return floor;
+}
+
+/**
+ * Iterate through the list of water floors and find the first water floor under a given point.
+ */
+struct Surface *find_water_floor_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 y, s32 z, f32 *pheight) {
+    f32 bottomHeight = FLOOR_LOWER_LIMIT;
+
+    find_water_bottom_from_list(surfaceNode, x, y, z, &bottomHeight);
+
+    return find_water_top_from_list(surfaceNode, x, z, bottomHeight, pheight);
+}
+
+#ifdef FLAT_STATIC_PARTITION
+/**
+ * Same as find_water_bottom_from_list, for a cell of the flattened static partition.
+ */
+static struct Surface *find_water_bottom_from_array(struct Surface *start, struct Surface *end, s32 x, s32 y, s32 z, f32 *pheight) {
+    struct Surface *surf;
+    struct Surface *bottom = NULL;
+    f32 curBottomHeight = FLOOR_LOWER_LIMIT;
+    f32 buffer = FIND_FLOOR_BUFFER;
+
+    // SURFACE_NEW_WATER_BOTTOM
+    for (surf = start; surf < end; surf++) {
+        if (!get_water_bottom_height(surf, x, z, &curBottomHeight)) continue;
 
-        // skip water tops or wall angled water bottoms
-        if (surf->type == SURFACE_NEW_WATER_BOTTOM || absf(surf->normal.y) < NORMAL_FLOOR_THRESHOLD) continue;
+        if (curBottomHeight >= y + buffer) {
+            *pheight = curBottomHeight;
+            bottom = surf;
+        }
+    }
 
-        if (!check_within_bounds_y_norm(x, z, surf)) continue;
+    return bottom;
+}
+
+/**
+ * Same as find_water_top_from_list, for a cell of the flattened static partition.
+ */
+static struct Surface *find_water_top_from_array(struct Surface *start, struct Surface *end, s32 x, s32 z, f32 bottomHeight, f32 *pheight) {
+    struct Surface *surf;
+    struct Surface *floor = NULL;
+    f32 height = FLOOR_LOWER_LIMIT;
+    f32 curHeight = FLOOR_LOWER_LIMIT;
 
-        curHeight = get_surface_height_at_location(x, z, surf);
+    // SURFACE_NEW_WATER
+    for (surf = start; surf < end; surf++) {
+        if (!get_water_top_height(surf, x, z, &curHeight)) continue;
 
         if (bottomHeight != FLOOR_LOWER_LIMIT && curHeight > bottomHeight) continue;
 
@@ -549,6 +908,43 @@ struct Surface *find_water_floor_from_list(struct SurfaceNode *surfaceNode, s32
     return floor;
 }
 
+/**
+ * Find the water floor under a point in a cell of the flattened static partition and in the
+ * surfaces that were loaded after it, as if both were still one list.
+ * Water lists are sorted by upperY, highest first, and surfaces loaded later come after the
+ * ones with the same upperY, which decides which one wins when the array and list both match.
+ */
+static struct Surface *find_water_floor_from_array_and_list(struct Surface **staticArray, struct SurfaceNode *surfaceNode,
+                                                            s32 x, s32 y, s32 z, f32 *pheight) {
+    f32 bottomHeight = FLOOR_LOWER_LIMIT;
+    f32 lateBottomHeight = FLOOR_LOWER_LIMIT;
+    f32 height = FLOOR_LOWER_LIMIT;
+    f32 lateHeight = FLOOR_LOWER_LIMIT;
+
+    // The old lookup kept the last water bottom above the point.
+    struct Surface *bottom = find_water_bottom_from_array(staticArray[0], staticArray[1], x, y, z, &bottomHeight);
+    struct Surface *lateBottom = find_water_bottom_from_list(surfaceNode, x, y, z, &lateBottomHeight);
+
+    if (lateBottom != NULL && (bottom == NULL || lateBottom->upperY <= bottom->upperY)) {
+        bottomHeight = lateBottomHeight;
+    }
+
+    // It also kept the first of the highest water tops under that bottom.
+    struct Surface *floor = find_water_top_from_array(staticArray[0], staticArray[1], x, z, bottomHeight, &height);
+    struct Surface *lateFloor = find_water_top_from_list(surfaceNode, x, z, bottomHeight, &lateHeight);
+
+    if (lateFloor != NULL && (floor == NULL || lateHeight > height || (lateHeight == height && lateFloor->upperY > floor->upperY))) {
+        *pheight = lateHeight;
+        return lateFloor;
+    }
+
+    if (floor == NULL) return NULL;
+
+    *pheight = height;
+    return STATIC_SURFACE_ORIGIN(floor);
+}
+#endif
+
 /**
  * Find the height of the highest floor below a point.
  */
@@ -623,8 +1019,23 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
     }
 
     // Check for surfaces that are a part of level geometry.
+#ifdef FLAT_STATIC_PARTITION
+    struct Surface **staticArray = STATIC_SURFACE_ARRAY(cellZ, cellX, SPATIAL_PARTITION_FLOORS);
+    floor = find_floor_from_array(staticArray, x, y, z, &height);
+
+    // Static surfaces loaded after the area itself are still kept in lists.
+    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
+    if (surfaceList != NULL) {
+        struct Surface *lateFloor = find_floor_from_list(surfaceList, x, y, z, &height);
+
+        if (lateFloor != NULL) {
+            floor = lateFloor;
+        }
+    }
+#else
     surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
     floor = find_floor_from_list(surfaceList, x, y, z, &height);
+#endif
 
     // Use the higher floor.
     if (includeDynamic && height <= dynamicHeight) {
@@ -690,8 +1101,15 @@ f32 find_water_floor(s32 xPos, s32 yPos, s32 zPos, struct Surface **pfloor) {
     s32 cellZ = GET_CELL_COORD(z);
 
     // Check for surfaces that are a part of level geometry.
+#ifdef FLAT_STATIC_PARTITION
+    // Static surfaces loaded after the area itself are still kept in lists.
+    struct Surface    **staticArray = STATIC_SURFACE_ARRAY(cellZ, cellX, SPATIAL_PARTITION_WATER);
+    struct SurfaceNode *surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER];
+    struct Surface     *floor       = find_water_floor_from_array_and_list(staticArray, surfaceList, x, y, z, &height);
+#else
     struct SurfaceNode *surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER];
     struct Surface     *floor       = find_water_floor_from_list(surfaceList, x, y, z, &height);
+#endif
 
     if (floor == NULL) {
         height = FLOOR_LOWER_LIMIT;
@@ -856,6 +1274,12 @@ void debug_surface_list_info(f32 xPos, f32 zPos) {
     s32 cellX = GET_CELL_COORD(xPos);
     s32 cellZ = GET_CELL_COORD(zPos);
 
+#ifdef FLAT_STATIC_PARTITION
+    numFloors += STATIC_SURFACE_ARRAY_LENGTH(cellZ, cellX, SPATIAL_PARTITION_FLOORS);
+    numWalls  += STATIC_SURFACE_ARRAY_LENGTH(cellZ, cellX, SPATIAL_PARTITION_WALLS);
+    numCeils  += STATIC_SURFACE_ARRAY_LENGTH(cellZ, cellX, SPATIAL_PARTITION_CEILS);
+#endif
+
     list = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
     numFloors += surface_list_length(list);
 
@@ -52,10 +52,99 @@ void *gDynamicSurfacePoolEnd;
  */
 u32 gTotalStaticSurfaceData;
 
+#ifdef FLAT_STATIC_PARTITION
+struct Surface *gStaticSurfaceArrays[(NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS) + 1];
+struct Surface *gStaticSurfaceCopies;
+struct Surface **gStaticSurfaceOrigins;
+
+/**
+ * While an area is loading, its static surface nodes are allocated downwards from the top of
+ * the static surface pool, so that they can be thrown away once the partition has been flattened.
+ */
+static struct SurfaceNode *sStaticNodePoolTop;
+static void *sStaticNodePoolEnd;
+#endif
+
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * An object's block of the dynamic surface pool. The object's surfaces and their nodes follow this header,
+ * and stay in the dynamic partition for as long as the object keeps loading the same collision model
+ * with the same transform each frame.
+ */
+struct DynamicSurfaceOwner {
+    u32 blockSize;
+    u32 generation; // sDynamicSurfaceGeneration when the object last loaded its collision
+    void *collisionData;
+    f32 transform[4][3];
+    u16 numSurfaces;
+    u16 numNodes;
+    u8 minCellX, maxCellX;
+    u8 minCellZ, maxCellZ;
+};
+
+/**
+ * A free block of the dynamic surface pool. The free list is kept in address order so that
+ * neighbouring blocks can be merged.
+ */
+struct DynamicSurfaceFreeBlock {
+    u32 size;
+    struct DynamicSurfaceFreeBlock *next;
+};
+
+static struct DynamicSurfaceOwner *sDynamicSurfaceOwners[OBJECT_POOL_MAX_CAPACITY];
+static struct DynamicSurfaceOwner *sLoadingOwner;
+static s32 sLoadingOwnerFull;
+static struct DynamicSurfaceFreeBlock *sDynamicSurfaceFreeList;
+static u32 sDynamicSurfaceGeneration;
+static u32 sDynamicSurfaceBytesUsed;
+static s32 sNumDynamicSurfaces;
+static s32 sNumDynamicSurfaceNodes;
+
+static void init_dynamic_surface_pool(void);
+
+/**
+ * Whether the object being loaded has room for another size bytes in its block of the pool. Once it runs out,
+ * nothing more is allocated for it, and load_object_dynamic_surfaces drops its collision.
+ */
+static s32 dynamic_surface_owner_has_room(u32 size) {
+    if (((uintptr_t) gDynamicSurfacePoolEnd + size) > ((uintptr_t) sLoadingOwner + sLoadingOwner->blockSize)) {
+        sLoadingOwnerFull = TRUE;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
+
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+struct StaticSurfaceYIndex *gStaticSurfaceYIndex;
+
+/**
+ * Cells with fewer surfaces than this are cheaper to scan whole.
+ */
+#define STATIC_Y_INDEX_MIN_SURFACES 12
+#endif
+
 /**
  * Allocate the part of the surface node pool to contain a surface node.
  */
 static struct SurfaceNode *alloc_surface_node(u32 dynamic) {
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    if (dynamic && !dynamic_surface_owner_has_room(sizeof(struct SurfaceNode))) {
+        return NULL;
+    }
+#endif
+#ifdef FLAT_STATIC_PARTITION
+    if (!dynamic && sStaticNodePoolTop != NULL) {
+        struct SurfaceNode *node = --sStaticNodePoolTop;
+        gSurfaceNodesAllocated++;
+
+        node->next = NULL;
+
+        return node;
+    }
+#endif
+
     struct SurfaceNode **poolEnd = (struct SurfaceNode **)(dynamic ? &gDynamicSurfacePoolEnd : &gCurrStaticSurfacePoolEnd);
 
     struct SurfaceNode *node = *poolEnd;
@@ -72,6 +161,12 @@ static struct SurfaceNode *alloc_surface_node(u32 dynamic) {
  * initialize the surface.
  */
 static struct Surface *alloc_surface(u32 dynamic) {
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    if (dynamic && !dynamic_surface_owner_has_room(sizeof(struct Surface))) {
+        return NULL;
+    }
+#endif
+
     struct Surface **poolEnd = (struct Surface **)(dynamic ? &gDynamicSurfacePoolEnd : &gCurrStaticSurfacePoolEnd);
     
     struct Surface *surface = *poolEnd;
@@ -87,6 +182,36 @@ static struct Surface *alloc_surface(u32 dynamic) {
     return surface;
 }
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * Whether a surface in the dynamic partition belongs to an object that hasn't loaded its collision yet
+ * this frame. When the partition is rebuilt every frame, such a surface comes after the surfaces of the
+ * object being loaded that have the same priority, so new surfaces are inserted before it. As long as the
+ * objects load in the same order every frame, the lists are then the same as they would be after a rebuild.
+ */
+static s32 dynamic_surface_loads_later(struct Surface *surface) {
+    struct DynamicSurfaceOwner *owner = sDynamicSurfaceOwners[get_object_pool_index(surface->object)];
+
+    // The object being loaded has no owner until it's done.
+    return (owner != NULL && owner->generation != sDynamicSurfaceGeneration);
+}
+#endif
+
+/**
+ * Whether a surface with the given priority goes before another surface of the same list.
+ */
+static ALWAYS_INLINE s32 surface_goes_before(s32 dynamic, s32 surfacePriority, struct Surface *other, s32 sortDir) {
+    s32 priority = other->upperY * sortDir;
+
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    if (dynamic && surfacePriority == priority) {
+        return dynamic_surface_loads_later(other);
+    }
+#endif
+
+    return (surfacePriority > priority);
+}
+
 /**
  * Add a surface to the correct cell list of surfaces.
  * @param dynamic Determines whether the surface is static or dynamic
@@ -96,7 +221,6 @@ static struct Surface *alloc_surface(u32 dynamic) {
  */
 static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surface *surface) {
     struct SurfaceNode **list;
-    s32 priority;
     s32 sortDir = 1; // highest to lowest, then insertion order (water and floors)
     s32 listIndex;
 
@@ -115,10 +239,16 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
     s32 surfacePriority = surface->upperY * sortDir;
 
     struct SurfaceNode *newNode = alloc_surface_node(dynamic);
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    if (newNode == NULL) {
+        return;
+    }
+#endif
     newNode->surface = surface;
 
     if (dynamic) {
         list = &gDynamicSurfacePartition[cellZ][cellX][listIndex];
+#ifndef INCREMENTAL_DYNAMIC_SURFACES
         if (sNumCellsUsed >= sizeof(sCellsUsed) / sizeof(struct CellCoords)) {
             sClearAllCells = TRUE;
         } else {
@@ -129,6 +259,7 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
                 sNumCellsUsed++;
             }
         }
+#endif
     } else {
         list = &gStaticSurfacePartition[cellZ][cellX][listIndex];
     }
@@ -141,8 +272,7 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
     struct SurfaceNode *curNode = *list;
 
     // Check if surface should be placed at the beginning of the list.
-    priority = curNode->surface->upperY * sortDir;
-    if (surfacePriority > priority) {
+    if (surface_goes_before(dynamic, surfacePriority, curNode->surface, sortDir)) {
         *list = newNode;
         newNode->next = curNode;
         return;
@@ -150,9 +280,7 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
 
     // Loop until we find the appropriate place for the surface in the list.
     while (curNode->next != NULL) {
-        priority = curNode->next->surface->upperY * sortDir;
-
-        if (surfacePriority > priority) {
+        if (surface_goes_before(dynamic, surfacePriority, curNode->next->surface, sortDir)) {
             break;
         }
 
@@ -220,6 +348,16 @@ static void add_surface(struct Surface *surface, s32 dynamic) {
     s32 minCellZ = lower_cell_index(minZ);
     s32 maxCellZ = upper_cell_index(maxZ);
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    // Remember which cells the object's surfaces were added to, so that they can be removed again.
+    if (dynamic) {
+        sLoadingOwner->minCellX = MIN(sLoadingOwner->minCellX, minCellX);
+        sLoadingOwner->maxCellX = MAX(sLoadingOwner->maxCellX, maxCellX);
+        sLoadingOwner->minCellZ = MIN(sLoadingOwner->minCellZ, minCellZ);
+        sLoadingOwner->maxCellZ = MAX(sLoadingOwner->maxCellZ, maxCellZ);
+    }
+#endif
+
     for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
         for (cellX = minCellX; cellX <= maxCellX; cellX++) {
             add_surface_to_cell(dynamic, cellX, cellZ, surface);
@@ -259,6 +397,11 @@ static struct Surface *read_surface_data(TerrainData *vertexData, TerrainData **
     vec3_scale(n, mag);
 
     struct Surface *surface = alloc_surface(dynamic);
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    if (surface == NULL) {
+        return NULL;
+    }
+#endif
 
     vec3s_copy(surface->vertex1, v[0]);
     vec3s_copy(surface->vertex2, v[1]);
@@ -408,6 +551,9 @@ static void load_environmental_regions(TerrainData **data) {
 void alloc_surface_pools(void) {
     gDynamicSurfacePool = main_pool_alloc(DYNAMIC_SURFACE_POOL_SIZE, MEMORY_POOL_LEFT);
     gDynamicSurfacePoolEnd = gDynamicSurfacePool;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    init_dynamic_surface_pool();
+#endif
 
     gCCMEnteredSlide = FALSE;
     reset_red_coins_collected();
@@ -469,6 +615,138 @@ u32 get_area_terrain_size(TerrainData *data) {
 }
 #endif
 
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+/**
+ * Build the Y bucket index of every cell of the flattened static partition with enough surfaces
+ * to be worth it, placing the bucket data at the end of the static surface pool.
+ */
+static void build_static_surface_y_index(void) {
+    s32 numLists = (NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS);
+    u16 *data = gCurrStaticSurfacePoolEnd;
+    struct Surface *surf;
+    s32 i, bucket;
+
+    for (i = 0; i < numLists; i++) {
+        struct StaticSurfaceYIndex *yIndex = &gStaticSurfaceYIndex[i];
+        struct Surface *start = gStaticSurfaceArrays[i];
+        struct Surface *end = gStaticSurfaceArrays[i + 1];
+        s32 minY = CELL_HEIGHT_LIMIT;
+        s32 maxY = FLOOR_LOWER_LIMIT;
+        s32 numIndices = 0;
+
+        yIndex->numBuckets = 0;
+
+        if ((end - start) < STATIC_Y_INDEX_MIN_SURFACES || (end - start) > 0xFFFF) continue;
+
+        for (surf = start; surf < end; surf++) {
+            minY = MIN(minY, surf->lowerY);
+            maxY = MAX(maxY, surf->upperY);
+        }
+
+        s32 numBuckets = ((maxY - minY) / STATIC_PARTITION_Y_BUCKET_SIZE) + 1;
+        if (numBuckets < 2) continue;
+
+        for (surf = start; surf < end; surf++) {
+            numIndices += ((surf->upperY - minY) / STATIC_PARTITION_Y_BUCKET_SIZE) - ((surf->lowerY - minY) / STATIC_PARTITION_Y_BUCKET_SIZE) + 1;
+        }
+
+        u16 *bucketStarts = data;
+        u16 *indices = (bucketStarts + numBuckets + 1);
+        if (numIndices > 0xFFFF || (void *)(indices + numIndices) > sStaticNodePoolEnd) continue;
+
+        // Count the surfaces in each bucket, then turn the counts into offsets.
+        bzero(bucketStarts, (numBuckets + 1) * sizeof(u16));
+        for (surf = start; surf < end; surf++) {
+            s32 lastBucket = ((surf->upperY - minY) / STATIC_PARTITION_Y_BUCKET_SIZE);
+            for (bucket = ((surf->lowerY - minY) / STATIC_PARTITION_Y_BUCKET_SIZE); bucket <= lastBucket; bucket++) {
+                bucketStarts[bucket + 1]++;
+            }
+        }
+        for (bucket = 0; bucket < numBuckets; bucket++) {
+            bucketStarts[bucket + 1] += bucketStarts[bucket];
+        }
+
+        // Fill the buckets in array order, using bucketStarts[bucket] as each bucket's cursor.
+        for (surf = start; surf < end; surf++) {
+            s32 lastBucket = ((surf->upperY - minY) / STATIC_PARTITION_Y_BUCKET_SIZE);
+            for (bucket = ((surf->lowerY - minY) / STATIC_PARTITION_Y_BUCKET_SIZE); bucket <= lastBucket; bucket++) {
+                indices[bucketStarts[bucket]++] = (surf - start);
+            }
+        }
+        for (bucket = numBuckets; bucket > 0; bucket--) {
+            bucketStarts[bucket] = bucketStarts[bucket - 1];
+        }
+        bucketStarts[0] = 0;
+
+        yIndex->minY = minY;
+        yIndex->numBuckets = numBuckets;
+        yIndex->bucketStarts = bucketStarts;
+
+        data = (indices + numIndices);
+    }
+
+    gCurrStaticSurfacePoolEnd = data;
+}
+#endif
+
+#ifdef FLAT_STATIC_PARTITION
+/**
+ * Copy every surface in the static partition lists into gStaticSurfaceArrays, placed right after
+ * the surfaces in the static surface pool, then drop the lists and the nodes at the top of the pool.
+ * If the copies would run into the nodes, the lists are kept as they are.
+ */
+static void flatten_static_surface_partition(void) {
+    struct SurfaceNode **list = &gStaticSurfacePartition[0][0][0];
+    struct SurfaceNode *node;
+    s32 numLists = (NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS);
+    s32 numEntries = 0;
+    s32 i;
+
+    for (i = 0; i < numLists; i++) {
+        for (node = list[i]; node != NULL; node = node->next) {
+            numEntries++;
+        }
+    }
+
+    struct Surface *copies = gCurrStaticSurfacePoolEnd;
+    struct Surface **origins = (struct Surface **)(copies + numEntries);
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+    struct StaticSurfaceYIndex *yIndex = (struct StaticSurfaceYIndex *)(origins + numEntries);
+    void *flatEnd = (yIndex + numLists);
+#else
+    void *flatEnd = (origins + numEntries);
+#endif
+
+    if (flatEnd > (void *)sStaticNodePoolTop) {
+        bzero(gStaticSurfaceArrays, sizeof(gStaticSurfaceArrays));
+        gCurrStaticSurfacePoolEnd = sStaticNodePoolEnd;
+        return;
+    }
+
+    gStaticSurfaceCopies = copies;
+    gStaticSurfaceOrigins = origins;
+
+    for (i = 0; i < numLists; i++) {
+        gStaticSurfaceArrays[i] = copies;
+
+        for (node = list[i]; node != NULL; node = node->next) {
+            *origins++ = node->surface;
+            *copies++ = *node->surface;
+        }
+
+        list[i] = NULL;
+    }
+    gStaticSurfaceArrays[numLists] = copies;
+
+    gCurrStaticSurfacePoolEnd = flatEnd;
+
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+    gStaticSurfaceYIndex = yIndex;
+    build_static_surface_y_index();
+#endif
+}
+#endif
+
 
 /**
  * Process the level file, loading in vertices, surfaces, some objects, and environmental
@@ -487,14 +765,22 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
     bzero(&sCellsUsed, sizeof(sCellsUsed));
     sNumCellsUsed = 0;
     sClearAllCells = TRUE;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    init_dynamic_surface_pool();
+#endif
 
     // Clear the static (level) surface partitions for new use.
     bzero(gStaticSurfacePartition, sizeof(gStaticSurfacePartition));
     gTotalStaticSurfaceData = 0;
 
     // Initialise a new surface pool for this block of static surface data
-    gCurrStaticSurfacePool = main_pool_alloc(main_pool_available() - 0x10, MEMORY_POOL_LEFT);
+    u32 poolSize = main_pool_available() - 0x10;
+    gCurrStaticSurfacePool = main_pool_alloc(poolSize, MEMORY_POOL_LEFT);
     gCurrStaticSurfacePoolEnd = gCurrStaticSurfacePool;
+#ifdef FLAT_STATIC_PARTITION
+    sStaticNodePoolEnd = (void *)(((uintptr_t)gCurrStaticSurfacePool + poolSize) & ~0x7);
+    sStaticNodePoolTop = sStaticNodePoolEnd;
+#endif
 
     // A while loop iterating through each section of the level data. Sections of data
     // are prefixed by a terrain "type." This type is reused for surfaces as the surface
@@ -532,6 +818,11 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
         }
     }
 
+#ifdef FLAT_STATIC_PARTITION
+    flatten_static_surface_partition();
+    sStaticNodePoolTop = NULL;
+#endif
+
     surfacePoolData = (uintptr_t)gCurrStaticSurfacePoolEnd - (uintptr_t)gCurrStaticSurfacePool;
     gTotalStaticSurfaceData += surfacePoolData;
     main_pool_realloc(gCurrStaticSurfacePool, surfacePoolData);
@@ -541,6 +832,180 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
     profiler_collision_update(first);
 }
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * Return a block to the dynamic surface pool, merging it with any free neighbours.
+ */
+static void free_dynamic_surface_block(void *addr, u32 size) {
+    struct DynamicSurfaceFreeBlock *block = addr;
+    struct DynamicSurfaceFreeBlock *prev = NULL;
+    struct DynamicSurfaceFreeBlock *next = sDynamicSurfaceFreeList;
+
+    while (next != NULL && next < block) {
+        prev = next;
+        next = next->next;
+    }
+
+    block->size = size;
+    block->next = next;
+
+    if (next != NULL && ((u8 *) block + block->size) == (u8 *) next) {
+        block->size += next->size;
+        block->next = next->next;
+    }
+
+    if (prev == NULL) {
+        sDynamicSurfaceFreeList = block;
+    } else if (((u8 *) prev + prev->size) == (u8 *) block) {
+        prev->size += block->size;
+        prev->next = block->next;
+    } else {
+        prev->next = block;
+    }
+}
+
+/**
+ * Remove an object's surfaces from the dynamic partition and free its block of the pool.
+ */
+static void remove_dynamic_surface_owner(s32 index) {
+    struct DynamicSurfaceOwner *owner = sDynamicSurfaceOwners[index];
+    struct Object *obj = get_object_from_pool_index(index);
+    struct SurfaceNode **list;
+    s32 cellX, cellZ, listIndex;
+
+    for (cellZ = owner->minCellZ; cellZ <= owner->maxCellZ; cellZ++) {
+        for (cellX = owner->minCellX; cellX <= owner->maxCellX; cellX++) {
+            for (listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+                list = &gDynamicSurfacePartition[cellZ][cellX][listIndex];
+
+                while (*list != NULL) {
+                    if ((*list)->surface->object == obj) {
+                        *list = (*list)->next;
+                    } else {
+                        list = &(*list)->next;
+                    }
+                }
+            }
+        }
+    }
+
+    sNumDynamicSurfaces -= owner->numSurfaces;
+    sNumDynamicSurfaceNodes -= owner->numNodes;
+    gSurfacesAllocated -= owner->numSurfaces;
+    gSurfaceNodesAllocated -= owner->numNodes;
+
+    sDynamicSurfaceBytesUsed -= owner->blockSize;
+    gDynamicSurfacePoolEnd = ((u8 *) gDynamicSurfacePool + sDynamicSurfaceBytesUsed);
+    free_dynamic_surface_block(owner, owner->blockSize);
+
+    sDynamicSurfaceOwners[index] = NULL;
+}
+
+/**
+ * Start loading an object's surfaces into the largest free block of the dynamic surface pool.
+ * The part of the block that isn't used is freed again by finish_dynamic_surface_owner.
+ */
+static struct DynamicSurfaceOwner *alloc_dynamic_surface_owner(void) {
+    struct DynamicSurfaceFreeBlock **largest = NULL;
+    struct DynamicSurfaceFreeBlock **block;
+
+    for (block = &sDynamicSurfaceFreeList; *block != NULL; block = &(*block)->next) {
+        if (largest == NULL || (*block)->size > (*largest)->size) {
+            largest = block;
+        }
+    }
+
+    if (largest == NULL || (*largest)->size < sizeof(struct DynamicSurfaceOwner)) {
+        assert(FALSE, "Dynamic surface pool size exceeded");
+        return NULL;
+    }
+
+    struct DynamicSurfaceOwner *owner = (struct DynamicSurfaceOwner *) *largest;
+    owner->blockSize = (*largest)->size;
+    *largest = (*largest)->next;
+
+    owner->numSurfaces = gSurfacesAllocated;
+    owner->numNodes = gSurfaceNodesAllocated;
+    owner->minCellX = owner->minCellZ = (NUM_CELLS - 1);
+    owner->maxCellX = owner->maxCellZ = 0;
+
+    // Surfaces and nodes are allocated right after the header, as they would be in the per-frame pool.
+    gDynamicSurfacePoolEnd = (owner + 1);
+
+    return owner;
+}
+
+/**
+ * Finish loading an object's surfaces, and give back the part of its block that wasn't needed.
+ */
+static void finish_dynamic_surface_owner(struct DynamicSurfaceOwner *owner) {
+    u32 size = ALIGN8((uintptr_t) gDynamicSurfacePoolEnd - (uintptr_t) owner);
+
+    assert(size <= owner->blockSize, "Dynamic surface pool size exceeded");
+
+    if ((owner->blockSize - size) >= sizeof(struct DynamicSurfaceFreeBlock)) {
+        free_dynamic_surface_block(((u8 *) owner + size), (owner->blockSize - size));
+        owner->blockSize = size;
+    }
+
+    owner->numSurfaces = (gSurfacesAllocated - owner->numSurfaces);
+    owner->numNodes = (gSurfaceNodesAllocated - owner->numNodes);
+    sNumDynamicSurfaces += owner->numSurfaces;
+    sNumDynamicSurfaceNodes += owner->numNodes;
+
+    sDynamicSurfaceBytesUsed += owner->blockSize;
+    gDynamicSurfacePoolEnd = ((u8 *) gDynamicSurfacePool + sDynamicSurfaceBytesUsed);
+}
+
+/**
+ * Remove every object's surfaces. The pool itself may already have been freed along with the level,
+ * so the free list is only rebuilt by alloc_surface_pools.
+ */
+void reset_dynamic_surfaces(void) {
+    bzero(sDynamicSurfaceOwners, sizeof(sDynamicSurfaceOwners));
+    bzero(gDynamicSurfacePartition, sizeof(gDynamicSurfacePartition));
+
+    sDynamicSurfaceFreeList = NULL;
+    gDynamicSurfacePoolEnd = gDynamicSurfacePool;
+
+    sDynamicSurfaceBytesUsed = 0;
+    sNumDynamicSurfaces = 0;
+    sNumDynamicSurfaceNodes = 0;
+}
+
+/**
+ * Remove every object's surfaces and make the whole dynamic surface pool free again.
+ */
+static void init_dynamic_surface_pool(void) {
+    reset_dynamic_surfaces();
+    free_dynamic_surface_block(gDynamicSurfacePool, DYNAMIC_SURFACE_POOL_SIZE);
+}
+
+/**
+ * Remove the surfaces of an object that is being unloaded.
+ */
+void unload_object_surfaces(struct Object *obj) {
+    s32 index = get_object_pool_index(obj);
+
+    if (sDynamicSurfaceOwners[index] != NULL) {
+        remove_dynamic_surface_owner(index);
+    }
+}
+
+/**
+ * Remove the surfaces of every object that didn't load its collision since clear_dynamic_surfaces.
+ */
+void unload_stale_dynamic_surfaces(void) {
+    PUPPYPRINT_GET_SNAPSHOT();
+    for (s32 i = 0; i < gObjectPoolCapacity; i++) {
+        if (sDynamicSurfaceOwners[i] != NULL && sDynamicSurfaceOwners[i]->generation != sDynamicSurfaceGeneration) {
+            remove_dynamic_surface_owner(i);
+        }
+    }
+    profiler_collision_update(first);
+}
+#endif
+
 /**
  * If not in time stop, clear the surface partitions.
  */
@@ -549,6 +1014,13 @@ void clear_dynamic_surfaces(void) {
     if (!(gTimeStopState & TIME_STOP_ACTIVE)) {
         clear_dynamic_surface_references();
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+        // Object surfaces are kept until the object moves or stops loading them,
+        // see load_object_dynamic_surfaces and unload_stale_dynamic_surfaces.
+        sDynamicSurfaceGeneration++;
+        gSurfacesAllocated = (gNumStaticSurfaces + sNumDynamicSurfaces);
+        gSurfaceNodesAllocated = (gNumStaticSurfaceNodes + sNumDynamicSurfaceNodes);
+#else
         gSurfacesAllocated = gNumStaticSurfaces;
         gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
         gDynamicSurfacePoolEnd = gDynamicSurfacePool;
@@ -561,27 +1033,32 @@ void clear_dynamic_surfaces(void) {
         }
         sNumCellsUsed = 0;
         sClearAllCells = FALSE;
+#endif
     }
     profiler_collision_update(first);
 }
 
 /**
- * Applies an object's transformation to the object's vertices.
+ * Get the transformation that the object's collision is loaded with.
  */
-void transform_object_vertices(TerrainData **data, TerrainData *vertexData) {
+static void get_object_collision_transform(Mat4 transform) {
     Mat4 *objectTransform = &o->transform;
 
-    register s32 numVertices = *(*data)++;
-
-    register TerrainData *vertices = *data;
-
     if (o->header.gfx.throwMatrix == NULL) {
         o->header.gfx.throwMatrix = objectTransform;
         obj_build_transform_from_pos_and_angle(o, O_POS_INDEX, O_FACE_ANGLE_INDEX);
     }
 
-    Mat4 transform;
     mtxf_scale_vec3f(transform, *objectTransform, o->header.gfx.scale);
+}
+
+/**
+ * Applies a transformation to an object's vertices.
+ */
+static void transform_vertices(TerrainData **data, TerrainData *vertexData, Mat4 transform) {
+    register s32 numVertices = *(*data)++;
+
+    register TerrainData *vertices = *data;
 
     // Go through all vertices, rotating and translating them to transform the object.
     Vec3f pos;
@@ -598,6 +1075,15 @@ void transform_object_vertices(TerrainData **data, TerrainData *vertexData) {
     *data = vertices;
 }
 
+/**
+ * Applies an object's transformation to the object's vertices.
+ */
+void transform_object_vertices(TerrainData **data, TerrainData *vertexData) {
+    Mat4 transform;
+    get_object_collision_transform(transform);
+    transform_vertices(data, vertexData, transform);
+}
+
 /**
  * Load in the surfaces for the o. This includes setting the flags, exertion, and room.
  */
@@ -672,6 +1158,71 @@ static void get_optimal_coll_dist(struct Object *obj) {
 
 static TerrainData sVertexData[600];
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * Load the object's collision into the dynamic partition, unless it's still there from
+ * an earlier frame with the same collision model and transformation.
+ */
+static void load_object_dynamic_surfaces(TerrainData *collisionData) {
+    s32 index = get_object_pool_index(o);
+    struct DynamicSurfaceOwner *owner = sDynamicSurfaceOwners[index];
+    Mat4 transform;
+    s32 i, j;
+
+    get_object_collision_transform(transform);
+
+    if (owner != NULL) {
+        s32 moved = (owner->collisionData != collisionData);
+        for (i = 0; i < 4 && !moved; i++) {
+            for (j = 0; j < 3; j++) {
+                if (owner->transform[i][j] != transform[i][j]) {
+                    moved = TRUE;
+                    break;
+                }
+            }
+        }
+
+        if (!moved) {
+            owner->generation = sDynamicSurfaceGeneration;
+            return;
+        }
+
+        remove_dynamic_surface_owner(index);
+    }
+
+    owner = alloc_dynamic_surface_owner();
+    if (owner == NULL) {
+        return;
+    }
+
+    owner->generation = sDynamicSurfaceGeneration;
+    owner->collisionData = collisionData;
+    for (i = 0; i < 4; i++) {
+        vec3f_copy(owner->transform[i], transform[i]);
+    }
+
+    sLoadingOwner = owner;
+    sLoadingOwnerFull = FALSE;
+
+    collisionData++;
+    transform_vertices(&collisionData, sVertexData, transform);
+
+    // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+    while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+        load_object_surfaces(&collisionData, sVertexData, TRUE);
+    }
+
+    finish_dynamic_surface_owner(owner);
+    sDynamicSurfaceOwners[index] = owner;
+
+    // Rather than keep part of the collision, drop all of it. The object tries again next frame.
+    if (sLoadingOwnerFull) {
+        assert(FALSE, "Dynamic surface pool size exceeded");
+        remove_dynamic_surface_owner(index);
+    }
+}
+#endif
+
 /**
  * Transform an object's vertices, reload them, and render the object.
  */
@@ -709,6 +1260,9 @@ void load_object_collision_model(void) {
         && inColRadius
         && !(o->activeFlags & ACTIVE_FLAG_IN_DIFFERENT_ROOM)
     ) {
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+        load_object_dynamic_surfaces(collisionData);
+#else
         collisionData++;
         transform_object_vertices(&collisionData, sVertexData);
 
@@ -716,7 +1270,14 @@ void load_object_collision_model(void) {
         while (*collisionData != TERRAIN_LOAD_CONTINUE) {
             load_object_surfaces(&collisionData, sVertexData, TRUE);
         }
+#endif
+    }
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    else if (!(gTimeStopState & TIME_STOP_ACTIVE)) {
+        // Out of range or in another room, so the object has no collision this frame.
+        unload_object_surfaces(o);
     }
+#endif
 
     f32 marioDist = o->oDistanceToMario;
 
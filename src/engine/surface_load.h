@@ -39,6 +39,41 @@ extern void *gCurrStaticSurfacePoolEnd;
 extern void *gDynamicSurfacePoolEnd;
 extern u32 gTotalStaticSurfaceData;
 
+#ifdef FLAT_STATIC_PARTITION
+/**
+ * The flattened static partition. Every cell's surfaces are copied into one contiguous block,
+ * in the same [z][x][partition] order as gStaticSurfacePartition. Entry i of gStaticSurfaceArrays
+ * is the first copy belonging to that cell/partition, and entry i + 1 is one past its last.
+ * Copies must never be handed out; STATIC_SURFACE_ORIGIN gives back the real surface.
+ * Surfaces added after the area has loaded (load_object_static_model) stay in gStaticSurfacePartition.
+ */
+extern struct Surface *gStaticSurfaceArrays[(NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS) + 1];
+extern struct Surface *gStaticSurfaceCopies;
+extern struct Surface **gStaticSurfaceOrigins;
+
+#define STATIC_SURFACE_ARRAY(cellZ, cellX, partition) (&gStaticSurfaceArrays[((((cellZ) * NUM_CELLS) + (cellX)) * NUM_SPATIAL_PARTITIONS) + (partition)])
+#define STATIC_SURFACE_ARRAY_LENGTH(cellZ, cellX, partition) (STATIC_SURFACE_ARRAY(cellZ, cellX, partition)[1] - STATIC_SURFACE_ARRAY(cellZ, cellX, partition)[0])
+#define STATIC_SURFACE_ORIGIN(surf) (gStaticSurfaceOrigins[(surf) - gStaticSurfaceCopies])
+#endif
+
+#ifdef STATIC_PARTITION_Y_BUCKET_SIZE
+/**
+ * Splits a cell of the flattened static partition into STATIC_PARTITION_Y_BUCKET_SIZE tall buckets, starting at minY.
+ * Each bucket lists the surfaces whose [lowerY, upperY] overlaps it, as indices into the cell's array, in array order.
+ * The indices of bucket i are [bucketStarts[i], bucketStarts[i + 1]) of the data that follows bucketStarts.
+ * numBuckets is 0 for cells that are scanned whole.
+ */
+struct StaticSurfaceYIndex {
+    s16 minY;
+    u16 numBuckets;
+    u16 *bucketStarts;
+};
+
+extern struct StaticSurfaceYIndex *gStaticSurfaceYIndex;
+
+#define STATIC_SURFACE_Y_INDEX(array) (&gStaticSurfaceYIndex[(array) - gStaticSurfaceArrays])
+#endif
+
 void alloc_surface_pools(void);
 #ifdef NO_SEGMENTED_MEMORY
 u32 get_area_terrain_size(TerrainData *data);
@@ -46,6 +81,11 @@ u32 get_area_terrain_size(TerrainData *data);
 void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, MacroObject *macroObjects);
 void clear_dynamic_surfaces(void);
 void load_object_collision_model(void);
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+void reset_dynamic_surfaces(void);
+void unload_object_surfaces(struct Object *obj);
+void unload_stale_dynamic_surfaces(void);
+#endif
 void load_object_static_model(void);
 
 #endif // SURFACE_LOAD_H
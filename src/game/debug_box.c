@@ -197,6 +197,30 @@ s32 gVisualOffset;
 extern s32 gSurfaceNodesAllocated;
 extern s32 gSurfacesAllocated;
 
+#ifdef FLAT_STATIC_PARTITION
+// The partition drawn by each pair of cases in iterate_surfaces_visual and iterate_surface_count.
+static const u8 sVisualPartitions[NUM_SPATIAL_PARTITIONS] = {
+    SPATIAL_PARTITION_WALLS,
+    SPATIAL_PARTITION_FLOORS,
+    SPATIAL_PARTITION_CEILS,
+    SPATIAL_PARTITION_WATER,
+};
+#endif
+
+static void make_visual_surface(Vtx *verts, struct Surface *surf, ColorRGB col) {
+    if (SURFACE_IS_INSTANT_WARP(surf->type)) {
+        make_vertex(verts, (gVisualSurfaceCount + 0), surf->vertex1[0], surf->vertex1[1], surf->vertex1[2], 0, 0, 0xFF, 0xA0, 0x00, 0x80);
+        make_vertex(verts, (gVisualSurfaceCount + 1), surf->vertex2[0], surf->vertex2[1], surf->vertex2[2], 0, 0, 0xFF, 0xA0, 0x00, 0x80);
+        make_vertex(verts, (gVisualSurfaceCount + 2), surf->vertex3[0], surf->vertex3[1], surf->vertex3[2], 0, 0, 0xFF, 0xA0, 0x00, 0x80);
+    } else {
+        make_vertex(verts, (gVisualSurfaceCount + 0), surf->vertex1[0], surf->vertex1[1], surf->vertex1[2], 0, 0, col[0], col[1], col[2], 0x80);
+        make_vertex(verts, (gVisualSurfaceCount + 1), surf->vertex2[0], surf->vertex2[1], surf->vertex2[2], 0, 0, col[0], col[1], col[2], 0x80);
+        make_vertex(verts, (gVisualSurfaceCount + 2), surf->vertex3[0], surf->vertex3[1], surf->vertex3[2], 0, 0, col[0], col[1], col[2], 0x80);
+    }
+
+    gVisualSurfaceCount += 3;
+}
+
 void iterate_surfaces_visual(s32 x, s32 z, Vtx *verts) {
     struct SurfaceNode *node;
     struct Surface *surf;
@@ -224,18 +248,19 @@ void iterate_surfaces_visual(s32 x, s32 z, Vtx *verts) {
             surf = node->surface;
             node = node->next;
 
-            if (SURFACE_IS_INSTANT_WARP(surf->type)) {
-                make_vertex(verts, (gVisualSurfaceCount + 0), surf->vertex1[0], surf->vertex1[1], surf->vertex1[2], 0, 0, 0xFF, 0xA0, 0x00, 0x80);
-                make_vertex(verts, (gVisualSurfaceCount + 1), surf->vertex2[0], surf->vertex2[1], surf->vertex2[2], 0, 0, 0xFF, 0xA0, 0x00, 0x80);
-                make_vertex(verts, (gVisualSurfaceCount + 2), surf->vertex3[0], surf->vertex3[1], surf->vertex3[2], 0, 0, 0xFF, 0xA0, 0x00, 0x80);
-            } else {
-                make_vertex(verts, (gVisualSurfaceCount + 0), surf->vertex1[0], surf->vertex1[1], surf->vertex1[2], 0, 0, col[0], col[1], col[2], 0x80);
-                make_vertex(verts, (gVisualSurfaceCount + 1), surf->vertex2[0], surf->vertex2[1], surf->vertex2[2], 0, 0, col[0], col[1], col[2], 0x80);
-                make_vertex(verts, (gVisualSurfaceCount + 2), surf->vertex3[0], surf->vertex3[1], surf->vertex3[2], 0, 0, col[0], col[1], col[2], 0x80);
-            }
+            make_visual_surface(verts, surf, col);
+        }
+
+#ifdef FLAT_STATIC_PARTITION
+        // Odd cases are the static partitions.
+        if (i & 1) {
+            struct Surface **array = STATIC_SURFACE_ARRAY(cellZ, cellX, sVisualPartitions[i / 2]);
 
-            gVisualSurfaceCount += 3;
+            for (surf = array[0]; surf < array[1]; surf++) {
+                make_visual_surface(verts, surf, col);
+            }
         }
+#endif
     }
 }
 
@@ -332,6 +357,12 @@ s32 iterate_surface_count(s32 x, s32 z) {
             node = node->next;
             j++;
         }
+
+#ifdef FLAT_STATIC_PARTITION
+        if (i & 1) {
+            j += STATIC_SURFACE_ARRAY_LENGTH(cellZ, cellX, sVisualPartitions[i / 2]);
+        }
+#endif
     }
     if (p != NULL) {
         numRegions = *p++;
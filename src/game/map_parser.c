@@ -3,19 +3,25 @@
 #include <stdarg.h>
 #include <string.h>
 #include "segments.h"
+#include "map_parser.h"
 
 #define STACK_TRAVERSAL_LIMIT 100
 
+// The map data is linked to run here, but is only loaded by map_data_init once the game has crashed.
+#define MAP_DATA_RAM_START (RAM_END - 0x100000)
+#define MAP_DATA_ROM_ADDR(ramAddr) ((u32) _mapDataSegmentRomStart + ((u32) (ramAddr) - MAP_DATA_RAM_START))
+
+// See tools/mapPacker.py.
 struct MapEntry {
 	u32 addr;
-	u32 nm_offset;
-	u32 nm_len;
-	u32 pad;
+	u32 nm_offset; // Into gMapStrings. Names end with a zero byte.
 };
 extern u8 gMapStrings[];
 extern struct MapEntry gMapEntries[];
 extern u32 gMapEntrySize;
-extern u8 _mapDataSegmentRomStart[];
+// Without DEBUG_MAP_STACKTRACE, sm64.ld sets this to 0. It's weak so that the compiler doesn't assume
+// its address is non-zero, and map_data_in_rom can check for that.
+extern u8 _mapDataSegmentRomStart[] __attribute__((weak));
 
 
 // code provided by Wiseguy
@@ -37,22 +43,108 @@ static u32 headless_pi_status(void)
 
 
 void map_data_init(void) {
-	headless_dma((u32)_mapDataSegmentRomStart, (u32*)(RAM_END - 0x100000), 0x100000);
+	headless_dma((u32)_mapDataSegmentRomStart, (u32*)MAP_DATA_RAM_START, 0x100000);
 	while (headless_pi_status() & (PI_STATUS_DMA_BUSY | PI_STATUS_ERROR));
 }
 
-char *parse_map(u32 pc) {
-	u32 i;
+/**
+ * Binary search for the last entry at or before pc, reading the entries with getAddr.
+ * Return -1 if pc is before the first entry or after the start of the last one, since where the last
+ * function ends isn't known.
+ */
+static s32 map_search(u32 pc, u32 numEntries, u32 (*getAddr)(u32 index)) {
+	u32 low = 0;
+	u32 high = numEntries;
+
+	while (low < high) {
+		u32 mid = (low + high) / 2;
+		if (getAddr(mid) <= pc) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
 
-	for (i = 0; i < gMapEntrySize; i++) {
-		if (gMapEntries[i].addr >= pc) break;
+	if (low == 0 || low == numEntries) {
+		return -1;
 	}
+	return (low - 1);
+}
+
+static u32 map_get_addr(u32 index) {
+	return gMapEntries[index].addr;
+}
 
-	if (i == gMapEntrySize - 1) {
+/**
+ * Return the name of the function pc is in, or NULL if it isn't known. The map data has to be loaded.
+ */
+char *parse_map(u32 pc) {
+	s32 index = map_search(pc, gMapEntrySize, map_get_addr);
+
+	if (index < 0) {
 		return NULL;
-	} else {
-		return (char*) ((u32)gMapStrings + gMapEntries[i - 1].nm_offset);
 	}
+	return (char*) ((u32)gMapStrings + gMapEntries[index].nm_offset);
+}
+
+/**
+ * The same search for symbolizing PCs sampled while the game is running, when the map data isn't
+ * loaded since its memory belongs to the main pool. The entries are searched in ROM one word at a
+ * time, which is about 16 PI reads for a map of 30000 functions.
+ */
+static u32 map_rom_read(void *ramAddr) {
+	u32 value;
+	osPiReadIo(MAP_DATA_ROM_ADDR(ramAddr), &value);
+	return value;
+}
+
+static u32 map_rom_get_addr(u32 index) {
+	return map_rom_read(&gMapEntries[index].addr);
+}
+
+static s32 map_data_in_rom(void) {
+	return (_mapDataSegmentRomStart != NULL);
+}
+
+/**
+ * Return the index of the function pc is in, or -1 if it isn't known. Samples can be counted by index,
+ * and only the names that are shown read with map_symbol_name_from_rom.
+ */
+s32 map_symbol_index_from_rom(u32 pc) {
+	if (!map_data_in_rom()) {
+		return -1;
+	}
+	return map_search(pc, map_rom_read(&gMapEntrySize), map_rom_get_addr);
+}
+
+/**
+ * Copy the name of a function found with map_symbol_index_from_rom into buf.
+ */
+void map_symbol_name_from_rom(s32 index, char *buf, u32 size) {
+	u32 i = 0;
+
+	if (size == 0) {
+		return;
+	}
+	if (!map_data_in_rom() || index < 0) {
+		buf[0] = '\0';
+		return;
+	}
+	u32 addr = ((u32)gMapStrings + map_rom_read(&gMapEntries[index].nm_offset));
+	// PI reads have to be word aligned.
+	u32 word = map_rom_read((void *) (addr & ~3));
+	while (i < size - 1) {
+		char c = (word >> (24 - ((addr & 3) * 8))) & 0xFF;
+		if (c == '\0') {
+			break;
+		}
+		buf[i++] = c;
+		addr++;
+		if ((addr & 3) == 0) {
+			word = map_rom_read((void *) addr);
+		}
+	}
+	buf[i] = '\0';
 }
 
 extern u8 _mainSegmentStart[];
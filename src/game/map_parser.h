@@ -0,0 +1,12 @@
+#ifndef MAP_PARSER_H
+#define MAP_PARSER_H
+
+#include <PR/ultratypes.h>
+
+void map_data_init(void);
+char *parse_map(u32 pc);
+char *find_function_in_stack(u32 *sp);
+s32 map_symbol_index_from_rom(u32 pc);
+void map_symbol_name_from_rom(s32 index, char *buf, u32 size);
+
+#endif // MAP_PARSER_H
@@ -20,6 +20,16 @@ struct AllocOnlyPool {
 };
 
 struct MemoryPool;
+struct TlsfPool;
+
+struct TlsfPoolStats {
+    u32 totalSpace;
+    u32 usedSpace;        // Including block headers
+    u32 largestFreeBlock; // The largest allocation that would currently succeed
+    u32 numUsedBlocks;
+    u32 numFreeBlocks;
+    u32 fragmentation;    // Percentage of the free space that's not in the largest free block
+};
 
 struct OffsetSizePair {
     u32 offset;
@@ -32,12 +42,24 @@ struct DmaTable {
     struct OffsetSizePair anim[1]; // dynamic size
 };
 
+struct PackedDmaState;
+
 struct DmaHandlerList {
     struct DmaTable *dmaTable;
     void *currentAddr;
     void *bufTarget;
+    struct PackedDmaState *packed; // NULL unless set up with setup_packed_dma_table_list
 };
 
+/**
+ * Each entry of a packed DMA table starts with this. It's followed by rawSize bytes that are loaded as they are,
+ * and then numValues s16 values packed by tools/mario_anims_converter.py.
+ */
+struct PackedDmaHeader {
+    u16 rawSize;
+    u16 numValues;
+} __attribute__((aligned(4)));
+
 #define EFFECTS_MEMORY_POOL 0x4000
 
 extern struct MemoryPool *gEffectsMemoryPool;
@@ -76,8 +98,14 @@ struct MemoryPool *mem_pool_init(u32 size, u32 side);
 void *mem_pool_alloc(struct MemoryPool *pool, u32 size);
 void mem_pool_free(struct MemoryPool *pool, void *addr);
 
+struct TlsfPool *tlsf_pool_init(u32 size, u32 side);
+void *tlsf_pool_alloc(struct TlsfPool *pool, u32 size);
+void tlsf_pool_free(struct TlsfPool *pool, void *addr);
+void tlsf_pool_get_stats(struct TlsfPool *pool, struct TlsfPoolStats *stats);
+
 void *alloc_display_list(u32 size);
 void setup_dma_table_list(struct DmaHandlerList *list, void *srcAddr, void *buffer);
+void setup_packed_dma_table_list(struct DmaHandlerList *list, void *srcAddr, void *buffer);
 s32 load_patchable_table(struct DmaHandlerList *list, s32 index);
 
 #endif // MEMORY_H
@@ -106,6 +106,248 @@ void check_collision_in_list(struct Object *a, struct Object *b, struct Object *
     }
 }
 
+#ifdef OBJECT_COLLISION_BROADPHASE
+/**
+ * Tangible objects are sorted into a grid of COLLISION_GRID_SIZE * COLLISION_GRID_SIZE cells by their hitbox
+ * bounds before collisions are checked. The grid wraps around, so objects far apart may share a cell, but two
+ * objects whose hitboxes overlap always share one.
+ */
+#define COLLISION_GRID_SIZE       16
+#define COLLISION_GRID_CELL_SHIFT 10 // 1024 units
+// Objects whose hitbox covers more cells than this along either axis are checked against every object instead.
+#define COLLISION_GRID_MAX_SPAN   2
+
+#define COLLISION_MASK_WORDS ((OBJECT_POOL_MAX_CAPACITY + 31) / 32)
+
+// Tangible objects are numbered, so the numbers need to fit every object in the pool.
+#if OBJECT_POOL_MAX_CAPACITY > 0xFF
+typedef u16 CollisionSeq;
+#else
+typedef u8 CollisionSeq;
+#endif
+
+struct CollisionGridEntry {
+    CollisionSeq seq;
+    s16 next;
+};
+
+/**
+ * The lists that players collide with, in the order they're checked. These are also all of the lists
+ * that take part in object collision.
+ */
+static const u8 sPlayerCollisionLists[] = {
+    OBJ_LIST_PLAYER,
+    OBJ_LIST_POLELIKE,
+    OBJ_LIST_LEVEL,
+    OBJ_LIST_GENACTOR,
+    OBJ_LIST_PUSHABLE,
+    OBJ_LIST_SURFACE,
+    OBJ_LIST_DESTRUCTIVE,
+};
+
+static const u8 sDestructiveCollisionLists[] = {
+    OBJ_LIST_DESTRUCTIVE,
+    OBJ_LIST_GENACTOR,
+    OBJ_LIST_PUSHABLE,
+    OBJ_LIST_SURFACE,
+};
+
+static const u8 sPushableCollisionLists[] = {
+    OBJ_LIST_PUSHABLE,
+};
+
+static s16 sCollisionGrid[COLLISION_GRID_SIZE][COLLISION_GRID_SIZE];
+static struct CollisionGridEntry sCollisionGridEntries[OBJECT_POOL_MAX_CAPACITY * COLLISION_GRID_MAX_SPAN * COLLISION_GRID_MAX_SPAN];
+static s32 sNumCollisionGridEntries;
+
+/**
+ * Tangible objects are numbered in the order of sPlayerCollisionLists, then by their position in their list,
+ * so that walking a range of numbers is the same as walking part of a list.
+ */
+static struct Object *sCollisionObjects[OBJECT_POOL_MAX_CAPACITY];
+static CollisionSeq sCollisionListStart[NUM_OBJ_LISTS];
+static CollisionSeq sCollisionListEnd[NUM_OBJ_LISTS];
+// Each tangible object's number and list, indexed by get_object_pool_index.
+static CollisionSeq sCollisionSeqOf[OBJECT_POOL_MAX_CAPACITY];
+static u8 sCollisionListOf[OBJECT_POOL_MAX_CAPACITY];
+
+static CollisionSeq sLargeCollisionObjects[OBJECT_POOL_MAX_CAPACITY];
+static s32 sNumLargeCollisionObjects;
+
+/**
+ * Get the range of grid cells that an object's hitbox covers.
+ * Returns FALSE if it covers too many cells to be put in the grid.
+ */
+static s32 get_collision_grid_bounds(struct Object *obj, s32 *minX, s32 *maxX, s32 *minZ, s32 *maxZ) {
+    // detect_object_hitbox_overlap squares the sum of the radii, so a negative radius still reaches that far.
+    f32 radius = absf(obj->hitboxRadius);
+
+    *minX = ((s32)(obj->oPosX - radius) >> COLLISION_GRID_CELL_SHIFT);
+    *maxX = ((s32)(obj->oPosX + radius) >> COLLISION_GRID_CELL_SHIFT);
+    *minZ = ((s32)(obj->oPosZ - radius) >> COLLISION_GRID_CELL_SHIFT);
+    *maxZ = ((s32)(obj->oPosZ + radius) >> COLLISION_GRID_CELL_SHIFT);
+
+    return (((*maxX - *minX) < COLLISION_GRID_MAX_SPAN) && ((*maxZ - *minZ) < COLLISION_GRID_MAX_SPAN));
+}
+
+/**
+ * Number every tangible object in the collision lists and sort them into the grid.
+ */
+static void build_collision_grid(void) {
+    s32 minX, maxX, minZ, maxZ;
+    s32 x, z, i;
+    s32 seq = 0;
+
+    for (z = 0; z < COLLISION_GRID_SIZE; z++) {
+        for (x = 0; x < COLLISION_GRID_SIZE; x++) {
+            sCollisionGrid[z][x] = -1;
+        }
+    }
+
+    sNumCollisionGridEntries = 0;
+    sNumLargeCollisionObjects = 0;
+
+    for (i = 0; i < ARRAY_COUNT(sPlayerCollisionLists); i++) {
+        s32 list = sPlayerCollisionLists[i];
+        struct Object *listHead = (struct Object *) &gObjectLists[list];
+        struct Object *obj = (struct Object *) listHead->header.next;
+
+        sCollisionListStart[list] = seq;
+
+        while (obj != listHead) {
+            // Intangibility timers only count down in clear_object_collision, so this holds for the whole frame.
+            if (obj->oIntangibleTimer == 0) {
+                s32 index = get_object_pool_index(obj);
+                sCollisionSeqOf[index] = seq;
+                sCollisionListOf[index] = list;
+                sCollisionObjects[seq] = obj;
+
+                if (get_collision_grid_bounds(obj, &minX, &maxX, &minZ, &maxZ)) {
+                    for (z = minZ; z <= maxZ; z++) {
+                        for (x = minX; x <= maxX; x++) {
+                            s16 *cell = &sCollisionGrid[z & (COLLISION_GRID_SIZE - 1)][x & (COLLISION_GRID_SIZE - 1)];
+                            struct CollisionGridEntry *entry = &sCollisionGridEntries[sNumCollisionGridEntries];
+
+                            entry->seq = seq;
+                            entry->next = *cell;
+                            *cell = sNumCollisionGridEntries++;
+                        }
+                    }
+                } else {
+                    sLargeCollisionObjects[sNumLargeCollisionObjects++] = seq;
+                }
+
+                seq++;
+            }
+
+            obj = (struct Object *) obj->header.next;
+        }
+
+        sCollisionListEnd[list] = seq;
+    }
+}
+
+/**
+ * Check an object against the objects in the given lists that its hitbox may overlap. This is
+ * equivalent to calling check_collision_in_list on each of the lists in turn, starting after the
+ * object itself in its own list.
+ */
+static void check_collision_in_lists(struct Object *a, const u8 *lists, s32 numLists) {
+    u32 nearby[COLLISION_MASK_WORDS];
+    s32 minX, maxX, minZ, maxZ;
+    s32 x, z, i;
+
+    if (a->oIntangibleTimer != 0) {
+        return;
+    }
+
+    // Mark the objects that share a cell with this one.
+    if (get_collision_grid_bounds(a, &minX, &maxX, &minZ, &maxZ)) {
+        bzero(nearby, sizeof(nearby));
+
+        for (z = minZ; z <= maxZ; z++) {
+            for (x = minX; x <= maxX; x++) {
+                s16 entry = sCollisionGrid[z & (COLLISION_GRID_SIZE - 1)][x & (COLLISION_GRID_SIZE - 1)];
+
+                while (entry >= 0) {
+                    u32 seq = sCollisionGridEntries[entry].seq;
+                    nearby[seq >> 5] |= BIT(seq & 0x1F);
+                    entry = sCollisionGridEntries[entry].next;
+                }
+            }
+        }
+
+        for (i = 0; i < sNumLargeCollisionObjects; i++) {
+            u32 seq = sLargeCollisionObjects[i];
+            nearby[seq >> 5] |= BIT(seq & 0x1F);
+        }
+    } else {
+        for (i = 0; i < COLLISION_MASK_WORDS; i++) {
+            nearby[i] = 0xFFFFFFFF;
+        }
+    }
+
+    // Then go through them list by list, in list order.
+    for (i = 0; i < numLists; i++) {
+        s32 seq = sCollisionListStart[lists[i]];
+        s32 end = sCollisionListEnd[lists[i]];
+
+        if (lists[i] == sCollisionListOf[get_object_pool_index(a)]) {
+            seq = (sCollisionSeqOf[get_object_pool_index(a)] + 1);
+        }
+
+        while (seq < end) {
+            u32 bits = (nearby[seq >> 5] >> (seq & 0x1F));
+
+            if (bits == 0) {
+                seq = ((seq | 0x1F) + 1);
+                continue;
+            }
+
+            if (bits & 1) {
+                struct Object *b = sCollisionObjects[seq];
+
+                if (detect_object_hitbox_overlap(a, b) && b->hurtboxRadius != 0.0f) {
+                    detect_object_hurtbox_overlap(a, b);
+                }
+            }
+            seq++;
+        }
+    }
+}
+
+void check_player_object_collision(void) {
+    struct Object *playerObj = (struct Object *) &gObjectLists[OBJ_LIST_PLAYER];
+    struct Object   *nextObj = (struct Object *) playerObj->header.next;
+
+    while (nextObj != playerObj) {
+        check_collision_in_lists(nextObj, sPlayerCollisionLists, ARRAY_COUNT(sPlayerCollisionLists));
+        nextObj = (struct Object *) nextObj->header.next;
+    }
+}
+
+void check_pushable_object_collision(void) {
+    struct Object *pushableObj = (struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE];
+    struct Object *nextObj = (struct Object *) pushableObj->header.next;
+
+    while (nextObj != pushableObj) {
+        check_collision_in_lists(nextObj, sPushableCollisionLists, ARRAY_COUNT(sPushableCollisionLists));
+        nextObj = (struct Object *) nextObj->header.next;
+    }
+}
+
+void check_destructive_object_collision(void) {
+    struct Object *destructiveObj = (struct Object *) &gObjectLists[OBJ_LIST_DESTRUCTIVE];
+    struct Object *nextObj = (struct Object *) destructiveObj->header.next;
+
+    while (nextObj != destructiveObj) {
+        if (nextObj->oDistanceToMario < 2000.0f && !(nextObj->activeFlags & ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY)) {
+            check_collision_in_lists(nextObj, sDestructiveCollisionLists, ARRAY_COUNT(sDestructiveCollisionLists));
+        }
+        nextObj = (struct Object *) nextObj->header.next;
+    }
+}
+#else
 void check_player_object_collision(void) {
     struct Object *playerObj = (struct Object *) &gObjectLists[OBJ_LIST_PLAYER];
     struct Object   *nextObj = (struct Object *) playerObj->header.next;
@@ -161,6 +403,7 @@ void check_destructive_object_collision(void) {
         nextObj = (struct Object *) nextObj->header.next;
     }
 }
+#endif
 
 void detect_object_collisions(void) {
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_POLELIKE]);
@@ -170,6 +413,9 @@ void detect_object_collisions(void) {
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_LEVEL]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_SURFACE]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_DESTRUCTIVE]);
+#ifdef OBJECT_COLLISION_BROADPHASE
+    build_collision_grid();
+#endif
     check_player_object_collision();
     check_destructive_object_collision();
     check_pushable_object_collision();
@@ -1655,13 +1655,13 @@ void cur_obj_spawn_particles(struct SpawnParticlesInfo *info) {
     s32 numParticles = info->count;
 
     // If there are a lot of objects already, limit the number of particles
-    if ((gPrevFrameObjectCount > (OBJECT_POOL_CAPACITY - 90)) && numParticles > 10) {
+    if ((gPrevFrameObjectCount > (gObjectPoolCapacity - 90)) && numParticles > 10) {
         numParticles = 10;
     }
 
     // We're close to running out of object slots, so don't spawn particles at
     // all
-    if (gPrevFrameObjectCount > (OBJECT_POOL_CAPACITY - 30)) {
+    if (gPrevFrameObjectCount > (gObjectPoolCapacity - 30)) {
         numParticles = 0;
     }
 
@@ -10,6 +10,7 @@
 #include "engine/surface_collision.h"
 #include "engine/surface_load.h"
 #include "engine/math_util.h"
+#include "game_init.h"
 #include "interaction.h"
 #include "level_update.h"
 #include "mario.h"
@@ -68,6 +69,16 @@ u32 gTimeStopState;
  */
 struct Object gObjectPool[OBJECT_POOL_CAPACITY];
 
+/**
+ * More objects for the current level, allocated from the main pool by RESERVE_OBJECTS.
+ */
+struct Object *gReservedObjects;
+
+/**
+ * The number of objects in gObjectPool and gReservedObjects together.
+ */
+s32 gObjectPoolCapacity = OBJECT_POOL_CAPACITY;
+
 /**
  * A special object whose purpose is to act as a parent for macro objects.
  */
@@ -282,6 +293,70 @@ void bhv_mario_update(void) {
     }
 }
 
+/**
+ * Update the current object, timing it by behavior if BEHAVIOR_PROFILING is enabled.
+ */
+static ALWAYS_INLINE void cur_obj_update_profiled(void) {
+    profiler_behavior_start();
+    cur_obj_update();
+    profiler_behavior_completed(o->behavior);
+}
+
+#ifdef OBJECT_UPDATE_SCHEDULER
+/**
+ * Return how many frames apart the current object should be updated: 1, 2 or 4.
+ * Anything Mario is holding, using or standing on is always updated every frame, and so is anything with a
+ * collision model, since its surfaces are only loaded by its update.
+ */
+static s32 get_cur_obj_update_rate(void) {
+    if (!(o->oFlags & OBJ_FLAG_REDUCED_UPDATE_RATE)
+        || o->collisionData != NULL
+        || gMarioObject == NULL
+        || o->oHeldState != HELD_FREE
+        || o == gMarioState->interactObj
+        || o == gMarioState->usedObj
+        || o == gMarioState->riddenObj
+        || o == gMarioObject->platform) {
+        return 1;
+    }
+
+    if (cur_obj_is_mario_in_room() == MARIO_OUTSIDE_ROOM) {
+        return 4;
+    }
+
+    Vec3f d;
+    vec3f_diff(d, &o->oPosVec, &gMarioObject->oPosVec);
+    f32 distSq = vec3_sumsq(d);
+    if (distSq > sqr(OBJECT_QUARTER_RATE_DIST)) {
+        return 4;
+    }
+    if (distSq > sqr(OBJECT_HALF_RATE_DIST)) {
+        return 2;
+    }
+    return 1;
+}
+
+/**
+ * Return whether the current object should be updated this frame. Objects on reduced rates are
+ * spread across the frames by their place in the object pool, so that they don't all update at once.
+ * When an object is updated, its timer is moved ahead by the frames it skipped.
+ */
+static s32 cur_obj_schedule_update(void) {
+    s32 rate = get_cur_obj_update_rate();
+
+    if (rate > 1 && ((gGlobalTimer + get_object_pool_index(o)) & (rate - 1)) != 0) {
+        o->framesSkipped++;
+        return FALSE;
+    }
+
+    if (o->framesSkipped != 0) {
+        o->oTimer = MIN(o->oTimer + o->framesSkipped, 0x3FFFFFFF);
+        o->framesSkipped = 0;
+    }
+    return TRUE;
+}
+#endif
+
 /**
  * Update every object that occurs after firstObj in the given object list,
  * including firstObj itself. Return the number of objects that were updated.
@@ -293,7 +368,13 @@ s32 update_objects_starting_at(struct ObjectNode *objList, struct ObjectNode *fi
         gCurrentObject = (struct Object *) firstObj;
 
         gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
-        cur_obj_update();
+#ifdef OBJECT_UPDATE_SCHEDULER
+        if (cur_obj_schedule_update()) {
+            cur_obj_update_profiled();
+        }
+#else
+        cur_obj_update_profiled();
+#endif
 
         firstObj = firstObj->next;
         count++;
@@ -340,7 +421,7 @@ s32 update_objects_during_time_stop(struct ObjectNode *objList, struct ObjectNod
         // Only update if unfrozen
         if (unfrozen) {
             gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
-            cur_obj_update();
+            cur_obj_update_profiled();
         } else {
             gCurrentObject->header.gfx.node.flags &= ~GRAPH_RENDER_HAS_ANIMATION;
         }
@@ -521,6 +602,13 @@ void clear_objects(void) {
 
     debug_unknown_level_select_check();
 
+#ifdef BEHAVIOR_NATIVE_LOOPS
+    clear_behavior_native_loops();
+#endif
+
+    // Reserved objects are freed along with the rest of the level.
+    gReservedObjects = NULL;
+    gObjectPoolCapacity = OBJECT_POOL_CAPACITY;
     init_free_object_list();
     clear_object_lists(gObjectListArray);
 
@@ -532,7 +620,11 @@ void clear_objects(void) {
     gObjectMemoryPool = mem_pool_init(OBJECT_MEMORY_POOL, MEMORY_POOL_LEFT);
     gObjectLists = gObjectListArray;
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    reset_dynamic_surfaces();
+#else
     clear_dynamic_surfaces();
+#endif
 }
 
 /**
@@ -547,6 +639,9 @@ void update_terrain_objects(void) {
     first = profiler_get_delta(PROFILER_DELTA_COLLISION);
 #endif
     gObjectCounter += update_objects_in_list(&gObjectLists[OBJ_LIST_SURFACE]);
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    unload_stale_dynamic_surfaces();
+#endif
     profiler_update(PROFILER_TIME_DYNAMIC, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
 
     // If the dynamic surface pool has overflowed, throw an error.
@@ -611,6 +706,35 @@ UNUSED static u16 unused_get_elapsed_time(u64 *cycleCounts, s32 index) {
     return time;
 }
 
+/**
+ * Add more objects to the pool for the current level, allocated from the main pool.
+ * A level can only do this once, and only up to MAX_RESERVED_OBJECTS.
+ */
+void reserve_objects(s32 count) {
+    assert(gReservedObjects == NULL, "Objects can only be reserved once per level.");
+    assert(count <= MAX_RESERVED_OBJECTS, "RESERVE_OBJECTS asks for more than MAX_RESERVED_OBJECTS.");
+    count = MIN(count, MAX_RESERVED_OBJECTS);
+    if (gReservedObjects != NULL || count <= 0) {
+        return;
+    }
+
+    gReservedObjects = main_pool_alloc(count * sizeof(struct Object), MEMORY_POOL_LEFT);
+    aggress(gReservedObjects != NULL, "Not enough memory for RESERVE_OBJECTS; use it before ALLOC_LEVEL_POOL.");
+    if (gReservedObjects == NULL) {
+        return;
+    }
+
+    for (s32 i = 0; i < count; i++) {
+        struct Object *obj = &gReservedObjects[i];
+
+        obj->activeFlags = ACTIVE_FLAG_DEACTIVATED;
+        geo_reset_object_node(&obj->header.gfx);
+        obj->header.next = gFreeObjectList.next;
+        gFreeObjectList.next = &obj->header;
+    }
+    gObjectPoolCapacity += count;
+}
+
 /**
  * Clear all floors tied to dynamic collision, as they become invalid once the dynamic
  * surfaces are cleared.
@@ -620,9 +744,10 @@ UNUSED static u16 unused_get_elapsed_time(u64 *cycleCounts, s32 index) {
  * Change this function to use a linked list instead if you add any additional logic here whatsoever.
  */
 void clear_dynamic_surface_references(void) {
-    for (s32 i = 0; i < OBJECT_POOL_CAPACITY; i++) {
-        if (gObjectPool[i].oFloor && gObjectPool[i].oFloor->flags & SURFACE_FLAG_DYNAMIC) {
-            gObjectPool[i].oFloor = NULL;
+    for (s32 i = 0; i < gObjectPoolCapacity; i++) {
+        struct Object *obj = get_object_from_pool_index(i);
+        if (obj->oFloor && obj->oFloor->flags & SURFACE_FLAG_DYNAMIC) {
+            obj->oFloor = NULL;
         }
     }
 }
@@ -22,9 +22,10 @@ enum gTimeStopStateFlags {
 };
 
 /**
- * The maximum number of objects that can be loaded at once.
+ * The number of objects that can be loaded at once, unless the level reserves more with RESERVE_OBJECTS.
  */
 #define OBJECT_POOL_CAPACITY 240
+#define OBJECT_POOL_MAX_CAPACITY (OBJECT_POOL_CAPACITY + MAX_RESERVED_OBJECTS)
 
 /**
  * Every object is categorized into an object list, which controls the order
@@ -79,6 +80,8 @@ extern s16 gDebugInfoOverwrite[][8];
 
 extern u32 gTimeStopState;
 extern struct Object gObjectPool[];
+extern struct Object *gReservedObjects;
+extern s32 gObjectPoolCapacity;
 extern struct Object gMacroObjectDefaultParent;
 extern struct ObjectNode *gObjectLists;
 extern struct ObjectNode gFreeObjectList;
@@ -98,6 +101,24 @@ extern s32 gNumStaticSurfaces;
 
 #define OBJECT_MEMORY_POOL 0x800
 
+/**
+ * Objects are numbered from 0 to gObjectPoolCapacity - 1, starting with gObjectPool and then the
+ * objects the level reserved.
+ */
+static ALWAYS_INLINE s32 get_object_pool_index(struct Object *obj) {
+    if (obj >= gObjectPool && obj < &gObjectPool[OBJECT_POOL_CAPACITY]) {
+        return (obj - gObjectPool);
+    }
+    return (OBJECT_POOL_CAPACITY + (obj - gReservedObjects));
+}
+
+static ALWAYS_INLINE struct Object *get_object_from_pool_index(s32 index) {
+    if (index < OBJECT_POOL_CAPACITY) {
+        return &gObjectPool[index];
+    }
+    return &gReservedObjects[index - OBJECT_POOL_CAPACITY];
+}
+
 extern struct MemoryPool *gObjectMemoryPool;
 
 enum CollisionFlags {
@@ -141,6 +162,7 @@ void set_object_respawn_info_bits(struct Object *obj, u8 bits);
 void unload_objects_from_area(UNUSED s32 unused, s32 areaIndex);
 void spawn_objects_from_info(UNUSED s32 unused, struct SpawnInfo *spawnInfo);
 void clear_objects(void);
+void reserve_objects(s32 count);
 void clear_dynamic_surface_references(void);
 void update_objects(UNUSED s32 unused);
 
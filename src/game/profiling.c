@@ -29,6 +29,20 @@ u32 audio_subset_starts[AUDIO_SUBSET_SIZE];
 u32 audio_subset_tallies[AUDIO_SUBSET_SIZE];
 #endif
 
+#ifdef BEHAVIOR_PROFILING
+// Hash table of the time spent on each behavior since the last report, by behavior script address.
+static struct BehaviorProfile behavior_profiles[BEHAVIOR_PROFILER_SLOTS];
+// Behaviors that didn't fit in the table.
+static struct BehaviorProfile behavior_profile_overflow;
+static u32 behavior_start;
+// Total time the audio thread has taken, which unlike preempted_time is never reset.
+static u32 behavior_preempted_total;
+static u32 behavior_preempted_start;
+
+struct BehaviorProfile gBehaviorProfileReport[BEHAVIOR_PROFILER_TOP_COUNT];
+u32 gBehaviorProfileReportCount;
+#endif
+
 static void buffer_update(ProfileTimeData* data, u32 new, int buffer_index) {
     u32 old = data->counts[buffer_index];
     data->total -= old;
@@ -56,6 +70,75 @@ void profiler_update(enum ProfilerTime which, u32 delta) {
     prev_time = cur_time;
 }
 
+#ifdef BEHAVIOR_PROFILING
+void profiler_behavior_start() {
+    behavior_preempted_start = behavior_preempted_total;
+    behavior_start = osGetCount();
+}
+
+void profiler_behavior_completed(const void *behavior) {
+    // Leave out the time the audio thread took in the middle of the update.
+    u32 cycles = (osGetCount() - behavior_start) - (behavior_preempted_total - behavior_preempted_start);
+    u32 slot = (((uintptr_t) behavior >> 2) * 2654435761U) >> 16;
+    struct BehaviorProfile *profile = &behavior_profile_overflow;
+
+    for (u32 i = 0; i < BEHAVIOR_PROFILER_SLOTS; i++) {
+        struct BehaviorProfile *entry = &behavior_profiles[(slot + i) & (BEHAVIOR_PROFILER_SLOTS - 1)];
+        if (entry->behavior == behavior || entry->behavior == NULL) {
+            entry->behavior = behavior;
+            profile = entry;
+            break;
+        }
+    }
+
+    profile->cycles += cycles;
+    profile->updates++;
+}
+
+/**
+ * Put the costliest behaviors since the last report in gBehaviorProfileReport, and start over.
+ */
+static void update_behavior_report() {
+    gBehaviorProfileReportCount = 0;
+
+    for (u32 i = 0; i <= BEHAVIOR_PROFILER_SLOTS; i++) {
+        struct BehaviorProfile *profile = (i < BEHAVIOR_PROFILER_SLOTS) ? &behavior_profiles[i] : &behavior_profile_overflow;
+        if (profile->updates == 0) {
+            continue;
+        }
+
+        // Insertion sort into the report, which is kept in order of cost.
+        u32 j = gBehaviorProfileReportCount;
+        if (j < BEHAVIOR_PROFILER_TOP_COUNT) {
+            gBehaviorProfileReportCount++;
+        } else if (profile->cycles <= gBehaviorProfileReport[--j].cycles) {
+            continue;
+        }
+        for (; j > 0 && gBehaviorProfileReport[j - 1].cycles < profile->cycles; j--) {
+            gBehaviorProfileReport[j] = gBehaviorProfileReport[j - 1];
+        }
+        gBehaviorProfileReport[j] = *profile;
+    }
+
+    for (u32 i = 0; i < gBehaviorProfileReportCount; i++) {
+        gBehaviorProfileReport[i].cycles /= PROFILING_BUFFER_SIZE;
+        gBehaviorProfileReport[i].updates /= PROFILING_BUFFER_SIZE;
+    }
+    bzero(behavior_profiles, sizeof(behavior_profiles));
+    bzero(&behavior_profile_overflow, sizeof(behavior_profile_overflow));
+
+#if defined(ISVPRINT) || defined(UNF)
+    if (fDebug && sPPDebugPage == PUPPYPRINT_PAGE_BEHAVIORS) {
+        osSyncPrintf("Behavior    Updates  Cycles\n");
+        for (u32 i = 0; i < gBehaviorProfileReportCount; i++) {
+            struct BehaviorProfile *profile = &gBehaviorProfileReport[i];
+            osSyncPrintf("%08X %10d %7d\n", (u32) profile->behavior, profile->updates, profile->cycles);
+        }
+    }
+#endif
+}
+#endif
+
 void profiler_rsp_started(enum ProfilerRSPTime which) {
     rsp_pending_times[which] = osGetCount();
 }
@@ -126,6 +209,9 @@ void profiler_audio_completed() {
     u32 cur_index = audio_buffer_index;
 
     preempted_time = time - audio_start;
+#ifdef BEHAVIOR_PROFILING
+    behavior_preempted_total += time - audio_start;
+#endif
     buffer_update(cur_data, time - audio_start, cur_index);
 
 #ifdef AUDIO_PROFILING
@@ -164,7 +250,6 @@ static void update_total_timer() {
 
 #ifdef PUPPYPRINT_DEBUG
 extern u8 sPPDebugPage;
-extern u8 fDebug;
 #endif
 
 static void update_rdp_timers() {
@@ -330,6 +415,9 @@ void profiler_frame_setup() {
 
     if (profile_buffer_index >= PROFILING_BUFFER_SIZE) {
         profile_buffer_index = 0;
+#ifdef BEHAVIOR_PROFILING
+        update_behavior_report();
+#endif
     }
 
     prev_time = cur_start = osGetCount();
@@ -11,6 +11,12 @@
  * Toggle this define to enable verbose audio profiling with Pupprprint Debug.
 */
 #define AUDIO_PROFILING
+
+/**
+ * Toggle this define to time every object's update by behavior, shown on its own Puppyprint Debug page.
+ * With ISVPRINT or UNF, the report is also printed over ISViewer or USB while that page is open.
+*/
+#define BEHAVIOR_PROFILING
 #endif
 
 #define OS_GET_COUNT_INLINE(x) asm volatile("mfc0 %0, $9" : "=r"(x): )
@@ -137,6 +143,27 @@ static ALWAYS_INLINE void profiler_rsp_yielded() {
 #define profiler_get_rdp_microseconds() 0
 #endif
 
+#ifdef BEHAVIOR_PROFILING
+// How many behaviors can be timed at once. Must be a power of two.
+#define BEHAVIOR_PROFILER_SLOTS 128
+// How many of the costliest behaviors are reported.
+#define BEHAVIOR_PROFILER_TOP_COUNT 10
+
+struct BehaviorProfile {
+    const void *behavior; // NULL for the behaviors that didn't fit in the table
+    u32 cycles;           // Per frame, averaged over PROFILING_BUFFER_SIZE frames in the report
+    u32 updates;          // Likewise
+};
+extern struct BehaviorProfile gBehaviorProfileReport[BEHAVIOR_PROFILER_TOP_COUNT];
+extern u32 gBehaviorProfileReportCount;
+
+void profiler_behavior_start();
+void profiler_behavior_completed(const void *behavior);
+#else
+#define profiler_behavior_start()
+#define profiler_behavior_completed(behavior)
+#endif
+
 #ifdef AUDIO_PROFILING
 #define AUDIO_SUBSET_SIZE PROFILER_TIME_SUB_AUDIO_END - PROFILER_TIME_SUB_AUDIO_START
 extern u32 audio_subset_starts[AUDIO_SUBSET_SIZE];
@@ -186,9 +213,21 @@ static ALWAYS_INLINE void profiler_audio_subset_complete_func(enum ProfilerTime
 enum ProfilerTimeAudioUnused {
     AUDIO_SUBSET_ENTRIES
 };
+#ifdef AUDIO_RENDER
+// The host audio renderer (tools/audio_render) times the same sections with the host's cycle counter.
+void audio_render_profiler_switch(s32 complete1, s32 complete2, s32 begin, const char *func);
+void audio_render_profiler_start_shared(s32 first, s32 new);
+
+#define AUDIO_PROFILER_SWITCH(complete, begin) audio_render_profiler_switch(complete - PROFILER_TIME_SUB_AUDIO_START, -1, \
+    begin - PROFILER_TIME_SUB_AUDIO_START, __func__)
+#define AUDIO_PROFILER_COMPLETE_AND_SWITCH(complete1, complete2, begin) audio_render_profiler_switch(complete1 - PROFILER_TIME_SUB_AUDIO_START, \
+    complete2 - PROFILER_TIME_SUB_AUDIO_START, begin - PROFILER_TIME_SUB_AUDIO_START, __func__)
+#define AUDIO_PROFILER_START_SHARED(first, new) audio_render_profiler_start_shared(first - PROFILER_TIME_SUB_AUDIO_START, new - PROFILER_TIME_SUB_AUDIO_START)
+#else
 #define AUDIO_PROFILER_SWITCH(complete, begin)
 #define AUDIO_PROFILER_COMPLETE_AND_SWITCH(complete1, complete2, begin)
 #define AUDIO_PROFILER_START_SHARED(first, new)
+#endif
 
 // These two are unused by the default audio profiler; left in for cases of manual profiling of smaller functions as needed
 #define AUDIO_PROFILER_START(which)
@@ -45,6 +45,7 @@ a modern game engine's developer's console.
 #include "audio/external.h"
 #include "audio/heap.h"
 #include "audio/load.h"
+#include "audio/playback.h"
 #include "hud.h"
 #include "debug_box.h"
 #include "color_presets.h"
@@ -409,6 +410,11 @@ static void print_audio_overview(void) {
                             colourChart[NUM_AUDIO_POOLS + i][2], 255);
         print_small_text_light(x, y, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
     }
+
+    y += 12;
+    sprintf(textBytes, "  Notes Stolen / Dropped:\t  %d / %d", gNoteAllocStats.steals, gNoteAllocStats.drops);
+    print_set_envcolour(255, 255, 255, 255);
+    print_small_text_light(x, y, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
 #else
         print_set_envcolour(255, 95, 95, 255);
         print_small_text(x + 8, y + 12, "Verbose audio profiling is disabled!\nPlease toggle the <COL_7F7FFFFF>AUDIO PROFILING<COL_--------> define\n"
@@ -521,6 +527,36 @@ void puppyprint_render_minimal(void) {
     print_basic_profiling();
 }
 
+#ifdef BEHAVIOR_PROFILING
+void puppyprint_render_behaviors(void) {
+    char textBytes[32];
+
+    prepare_blank_box();
+    render_blank_box(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 0, 96);
+    finish_blank_box();
+
+    print_small_text_light(16, 24, "Behavior", PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+    print_small_text_light(160, 24, "Updates", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+    print_small_text_light(SCREEN_WIDTH - 16, 24, "Time", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+
+    for (u32 i = 0; i < gBehaviorProfileReportCount; i++) {
+        struct BehaviorProfile *profile = &gBehaviorProfileReport[i];
+        s32 y = (40 + (i * 12));
+
+        if (profile->behavior != NULL) {
+            sprintf(textBytes, "%08X", (u32) profile->behavior);
+        } else {
+            sprintf(textBytes, "Other");
+        }
+        print_small_text_light(16, y, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+        sprintf(textBytes, "%d", profile->updates);
+        print_small_text_light(160, y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+        sprintf(textBytes, "%d" PP_CYCLE_STRING, (s32) PP_CYCLE_CONV(profile->cycles));
+        print_small_text_light(SCREEN_WIDTH - 16, y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    }
+}
+#endif
+
 void render_coverage_map(void) {
     Gfx *tempGfxHead = gDisplayListHead;
 
@@ -996,7 +1032,7 @@ void puppyprint_render_general_vars(void) {
 
     sprintf(textBytes, "World\n\nObjects: %d/%d\n\nLevel ID: %d\nCourse ID: %d\nArea ID: %d\nRoom ID: %d\n\nInteract:   \n0x%08X\nWarp: 0x%02X", 
             gObjectCounter, 
-            OBJECT_POOL_CAPACITY,
+            gObjectPoolCapacity,
             gCurrLevelNum,
             gCurrCourseNum,
             gCurrAreaIndex,
@@ -1032,6 +1068,9 @@ struct PuppyPrintPage ppPages[] = {
 #ifdef USE_PROFILER
     [PUPPYPRINT_PAGE_PROFILER]      = {&puppyprint_render_standard,     "Profiler"},
     [PUPPYPRINT_PAGE_MINIMAL]       = {&puppyprint_render_minimal,      "Minimal"},
+#endif
+#ifdef BEHAVIOR_PROFILING
+    [PUPPYPRINT_PAGE_BEHAVIORS]     = {&puppyprint_render_behaviors,    "Behaviors"},
 #endif
     [PUPPYPRINT_PAGE_GENERAL]       = {&puppyprint_render_general_vars, "General"},
     [PUPPYPRINT_PAGE_AUDIO]         = {&print_audio_overview,           "Audio"},
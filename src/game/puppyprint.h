@@ -87,6 +87,9 @@ enum PPPages {
 #ifdef USE_PROFILER
     PUPPYPRINT_PAGE_PROFILER,
     PUPPYPRINT_PAGE_MINIMAL,
+#endif
+#ifdef BEHAVIOR_PROFILING
+    PUPPYPRINT_PAGE_BEHAVIORS,
 #endif
     PUPPYPRINT_PAGE_GENERAL,
     PUPPYPRINT_PAGE_AUDIO,
@@ -120,6 +123,7 @@ enum PuppyFont {
 };
 
 extern u8 sPPDebugPage;
+extern u8 fDebug;
 extern u8 gPuppyFont;
 extern ColorRGBA gCurrEnvCol;
 extern s32 ramsizeSegment[33];
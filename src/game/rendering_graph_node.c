@@ -64,6 +64,7 @@ struct GeoAnimState {
     /*0x04*/ f32 translationMultiplier;
     /*0x08*/ u16 *attribute;
     /*0x0C*/ s16 *data;
+    /*0x10*/ s16 *pose;
 };
 
 // For some reason, this is a GeoAnimState struct, but the current state consists
@@ -76,6 +77,9 @@ s16 gCurrAnimFrame;
 f32 gCurrAnimTranslationMultiplier;
 u16 *gCurrAnimAttribute;
 s16 *gCurrAnimData;
+// The values of the current frame in order, if they are decoded already. Otherwise they are read through
+// gCurrAnimAttribute.
+s16 *gCurrAnimPose;
 
 struct AllocOnlyPool *gDisplayListHeap;
 
@@ -248,6 +252,150 @@ Mtx identityMatrixWorldScale = {{
      0x00000000,                            LOWER_FIXED(1.0f)               <<  0}
 }};
 
+static f32 get_dist_from_camera(Vec3f pos) {
+    return -((gCameraTransform[0][2] * pos[0])
+           + (gCameraTransform[1][2] * pos[1])
+           + (gCameraTransform[2][2] * pos[2])
+           +  gCameraTransform[3][2]);
+}
+
+#ifdef SORT_DISPLAY_LISTS
+// How many commands to look through for the first texture of a display list, including called lists.
+#define SORT_KEY_SCAN_LIMIT 32
+#define SORT_KEY_SCAN_DEPTH 4
+
+/**
+ * Layers whose display lists are sorted. A display list can set render state for the ones after it, like the
+ * environment color from geo_update_layer_transparency, so see group_display_list_nodes for what keeps its order.
+ */
+static const u32 sSortedLayers = (BIT(LAYER_OPAQUE) | BIT(LAYER_OPAQUE_INTER) | BIT(LAYER_ALPHA)
+#if SILHOUETTE
+    | BIT(LAYER_SILHOUETTE_OPAQUE) | BIT(LAYER_SILHOUETTE_ALPHA)
+    | BIT(LAYER_OCCLUDE_SILHOUETTE_OPAQUE) | BIT(LAYER_OCCLUDE_SILHOUETTE_ALPHA)
+#endif
+);
+
+/**
+ * Returns a 16 bit hash of the first texture image a display list sets, following the display lists it calls,
+ * or 0 if none is found within SORT_KEY_SCAN_LIMIT commands.
+ */
+static u32 get_display_list_texture_key(void *displayList) {
+    Gfx *stack[SORT_KEY_SCAN_DEPTH];
+    s32 depth = 0;
+    Gfx *cmd = segmented_to_virtual(displayList);
+
+    for (s32 i = 0; i < SORT_KEY_SCAN_LIMIT; i++, cmd++) {
+        u32 opcode = (cmd->words.w0 >> 24);
+        if (opcode == G_SETTIMG) {
+            u32 addr = cmd->words.w1;
+            return ((addr ^ (addr >> 16)) & 0xFFFF);
+        } else if (opcode == G_DL) {
+            if (((cmd->words.w0 >> 16) & 0xFF) == G_DL_PUSH) {
+                if (depth == SORT_KEY_SCAN_DEPTH) {
+                    break;
+                }
+                stack[depth++] = cmd;
+            }
+            cmd = (Gfx *) segmented_to_virtual((void *) cmd->words.w1) - 1;
+        } else if (opcode == G_ENDDL) {
+            if (depth == 0) {
+                break;
+            }
+            cmd = stack[--depth];
+        }
+    }
+    return 0;
+}
+
+/**
+ * Give the display lists that have to stay together the same sort key, so that sorting moves them as one group and
+ * keeps their order. All of an object's display lists in a layer are a group, since the state one of them sets can
+ * be meant for the rest, and objects are drawn one at a time, so those are always next to each other. Outside of
+ * objects, a display list without a texture joins the one after it, since it may only set state for it.
+ * A group sorts by its first texture.
+ */
+static void group_display_list_nodes(struct DisplayListNode *head) {
+    while (head != NULL) {
+        struct DisplayListNode *last = head;
+        struct DisplayListNode *keyNode = NULL;
+
+        while (TRUE) {
+            if (keyNode == NULL && (last->sortKey >> 16) != 0) {
+                keyNode = last;
+            }
+            if (last->next == NULL) {
+                break;
+            }
+            if (last->sortGroup != NULL) {
+                if (last->next->sortGroup != last->sortGroup) {
+                    break;
+                }
+            } else if (keyNode != NULL || last->next->sortGroup != NULL) {
+                break;
+            }
+            last = last->next;
+        }
+
+        u32 sortKey = (keyNode != NULL) ? keyNode->sortKey : last->sortKey;
+        for (struct DisplayListNode *curr = head; curr != last->next; curr = curr->next) {
+            curr->sortKey = sortKey;
+        }
+        head = last->next;
+    }
+}
+
+/**
+ * Sort a layer's display lists by their sort keys, using a merge sort that keeps the order of equal keys.
+ */
+static struct DisplayListNode *sort_display_list_nodes(struct DisplayListNode *head) {
+    struct DisplayListNode *runs[2];
+    struct DisplayListNode **tails[2];
+    struct DisplayListNode *merged;
+    struct DisplayListNode **mergedTail;
+    s32 width = 1;
+
+    if (head == NULL || head->next == NULL) {
+        return head;
+    }
+
+    // Merge runs of 'width' nodes in pairs, doubling 'width' until one run is left.
+    while (TRUE) {
+        struct DisplayListNode *rest = head;
+        s32 numMerges = 0;
+
+        merged = NULL;
+        mergedTail = &merged;
+        while (rest != NULL) {
+            numMerges++;
+            for (s32 r = 0; r < 2; r++) {
+                runs[r] = rest;
+                tails[r] = &runs[r];
+                for (s32 i = 0; i < width && rest != NULL; i++) {
+                    tails[r] = &rest->next;
+                    rest = rest->next;
+                }
+                *tails[r] = NULL;
+            }
+            while (runs[0] != NULL && runs[1] != NULL) {
+                s32 r = (runs[1]->sortKey < runs[0]->sortKey);
+                *mergedTail = runs[r];
+                mergedTail = &runs[r]->next;
+                runs[r] = runs[r]->next;
+            }
+            *mergedTail = (runs[0] != NULL) ? runs[0] : runs[1];
+            while (*mergedTail != NULL) {
+                mergedTail = &(*mergedTail)->next;
+            }
+        }
+        head = merged;
+        if (numMerges <= 1) {
+            return head;
+        }
+        width *= 2;
+    }
+}
+#endif
+
 /**
  * Process a master list node. This has been modified, so now it runs twice, for each microcode.
  * It iterates through the first 5 layers of if the first index using F3DLX2.Rej, then it switches
@@ -268,6 +416,16 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
     struct RenderModeContainer *mode2List = &renderModeTable_2Cycle[enableZBuffer];
     Gfx *tempGfxHead = gDisplayListHead;
 
+#ifdef SORT_DISPLAY_LISTS
+    // Group objects and display lists that use the same texture, to save the RDP from switching between them.
+    for (currLayer = LAYER_FIRST; currLayer < LAYER_COUNT; currLayer++) {
+        if (sSortedLayers & BIT(currLayer)) {
+            group_display_list_nodes(node->listHeads[currLayer]);
+            node->listHeads[currLayer] = sort_display_list_nodes(node->listHeads[currLayer]);
+        }
+    }
+#endif
+
     // Loop through the render phases
     for (phaseIndex = RENDER_PHASE_FIRST; phaseIndex < finalPhase; phaseIndex++) {
         if (enableZBuffer) {
@@ -374,6 +532,15 @@ void geo_append_display_list(void *displayList, s32 layer) {
         listNode->transform = gMatStackFixed[gMatStackIndex];
         listNode->displayList = displayList;
         listNode->next = NULL;
+#ifdef SORT_DISPLAY_LISTS
+        if (sSortedLayers & BIT(layer)) {
+            // Sort by texture first, then front to back.
+            f32 depth = get_dist_from_camera(gMatStack[gMatStackIndex][3]);
+            u32 depthKey = (depth <= 0.0f) ? 0 : (depth >= 65535.0f) ? 0xFFFF : (u32) depth;
+            listNode->sortKey = ((get_display_list_texture_key(displayList) << 16) | depthKey);
+            listNode->sortGroup = gCurGraphNodeObject;
+        }
+#endif
         if (gCurGraphNodeMasterList->listHeads[layer] == NULL) {
             gCurGraphNodeMasterList->listHeads[layer] = listNode;
         } else {
@@ -383,11 +550,139 @@ void geo_append_display_list(void *displayList, s32 layer) {
     }
 }
 
+#ifdef MATRIX_CACHE_SIZE
+/**
+ * The last matrix built for a node, with what it was built from. If none of that changes, the node keeps using
+ * the same fixed point matrix instead of building a new one every frame.
+ */
+struct MatrixCache {
+    Mtx mtx[2]; // Double buffered, since the RSP may still be reading last frame's.
+    Mat4 mtxf;
+    struct GraphNode *owner;
+    Vec3f translation;
+    Vec3f scale;
+    Vec3s rotation;
+    u8 curMtx;
+    u8 relative; // Whether the matrix depends on its parent's.
+    u32 version;
+    u32 parentVersion;
+};
+
+// A hash table of caches by node. Lookups give up after this many entries.
+#define MATRIX_CACHE_PROBES 8
+#define vec3_equal(a, b) (((a)[0] == (b)[0]) && ((a)[1] == (b)[1]) && ((a)[2] == (b)[2]))
+static struct MatrixCache sMatrixCaches[MATRIX_CACHE_SIZE];
+
+/**
+ * The version of each matrix on the stack. Cached matrices get a new version whenever they are rebuilt,
+ * while 0 means the matrix wasn't cached, so nothing built from it can be reused.
+ */
+static u32 sMatStackVersions[ARRAY_COUNT(gMatStack)];
+static u32 sMatrixCacheVersion = 1;
+
+/**
+ * Forget every cached matrix. Called when the graph nodes they belong to are freed.
+ */
+void reset_matrix_caches(void) {
+    for (s32 i = 0; i < MATRIX_CACHE_SIZE; i++) {
+        sMatrixCaches[i].owner = NULL;
+    }
+}
+
+/**
+ * Find the matrix cache for a node, or claim one for it. Returns NULL if the node can't be cached,
+ * either because the table is full or because it's part of a model shared by several objects.
+ */
+static struct MatrixCache *get_matrix_cache(struct GraphNode *owner) {
+    if (gCurGraphNodeObject != NULL || gCurGraphNodeHeldObject != NULL) {
+        return NULL;
+    }
+
+    u32 index = ((((uintptr_t) owner >> 3) * 2654435761U) >> 16);
+    for (s32 i = 0; i < MATRIX_CACHE_PROBES; i++, index++) {
+        struct MatrixCache *cache = &sMatrixCaches[index % MATRIX_CACHE_SIZE];
+        if (cache->owner == owner) {
+            return cache;
+        }
+        if (cache->owner == NULL) {
+            cache->owner = owner;
+            cache->version = 0;
+            return cache;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * If the node's matrix can be reused, copy it to the next matrix on the stack and return TRUE.
+ * Otherwise remember what it will be built from and return FALSE.
+ */
+static s32 use_cached_matrix(struct MatrixCache *cache, Vec3f translation, Vec3s rotation, Vec3f scale, s32 relative) {
+    if (cache == NULL) {
+        return FALSE;
+    }
+
+    u32 parentVersion = (relative ? sMatStackVersions[gMatStackIndex] : 0);
+    if (cache->version != 0
+        && cache->relative == relative
+        && (!relative || (parentVersion != 0 && parentVersion == cache->parentVersion))
+        && vec3_equal(cache->translation, translation)
+        && vec3_equal(cache->scale, scale)
+        && vec3_equal(cache->rotation, rotation)) {
+        mtxf_copy(gMatStack[gMatStackIndex + 1], cache->mtxf);
+        return TRUE;
+    }
+
+    vec3f_copy(cache->translation, translation);
+    vec3f_copy(cache->scale, scale);
+    vec3s_copy(cache->rotation, rotation);
+    cache->relative = relative;
+    cache->parentVersion = parentVersion;
+    cache->version = 0;
+    return FALSE;
+}
+#else
+static ALWAYS_INLINE struct MatrixCache *get_matrix_cache(UNUSED struct GraphNode *owner) {
+    return NULL;
+}
+
+static ALWAYS_INLINE s32 use_cached_matrix(UNUSED struct MatrixCache *cache, UNUSED Vec3f translation,
+                                           UNUSED Vec3s rotation, UNUSED Vec3f scale, UNUSED s32 relative) {
+    return FALSE;
+}
+#endif
+
 static void inc_mat_stack() {
     Mtx *mtx = alloc_display_list(sizeof(*mtx));
     gMatStackIndex++;
     mtxf_to_mtx(mtx, gMatStack[gMatStackIndex]);
     gMatStackFixed[gMatStackIndex] = mtx;
+#ifdef MATRIX_CACHE_SIZE
+    sMatStackVersions[gMatStackIndex] = 0;
+#endif
+}
+
+/**
+ * Push the matrix for a node that was either reused by use_cached_matrix, or built in the next matrix
+ * on the stack, in which case its cache is updated.
+ */
+static void push_matrix(struct MatrixCache *cache) {
+#ifdef MATRIX_CACHE_SIZE
+    if (cache != NULL) {
+        gMatStackIndex++;
+        if (cache->version == 0) {
+            // Write the buffer that the last frame didn't use.
+            cache->curMtx ^= 1;
+            mtxf_copy(cache->mtxf, gMatStack[gMatStackIndex]);
+            mtxf_to_mtx(&cache->mtx[cache->curMtx], gMatStack[gMatStackIndex]);
+            cache->version = ++sMatrixCacheVersion;
+        }
+        gMatStackFixed[gMatStackIndex] = &cache->mtx[cache->curMtx];
+        sMatStackVersions[gMatStackIndex] = cache->version;
+        return;
+    }
+#endif
+    inc_mat_stack();
 }
 
 static void append_dl_and_return(struct GraphNodeDisplayList *node) {
@@ -481,13 +776,6 @@ void geo_process_perspective(struct GraphNodePerspective *node) {
     }
 }
 
-static f32 get_dist_from_camera(Vec3f pos) {
-    return -((gCameraTransform[0][2] * pos[0])
-           + (gCameraTransform[1][2] * pos[1])
-           + (gCameraTransform[2][2] * pos[2])
-           +  gCameraTransform[3][2]);
-}
-
 /**
  * Process a level of detail node. From the current transformation matrix,
  * the perpendicular distance to the camera is extracted and the children
@@ -621,12 +909,15 @@ void geo_process_camera(struct GraphNodeCamera *node) {
  * For the rest it acts as a normal display list node.
  */
 void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node) {
+    struct MatrixCache *cache = get_matrix_cache(&node->node);
     Vec3f translation;
 
     vec3s_to_vec3f(translation, node->translation);
-    mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!use_cached_matrix(cache, translation, node->rotation, gVec3fOne, TRUE)) {
+        mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    }
 
-    inc_mat_stack();
+    push_matrix(cache);
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -636,12 +927,15 @@ void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node)
  * For the rest it acts as a normal display list node.
  */
 void geo_process_translation(struct GraphNodeTranslation *node) {
+    struct MatrixCache *cache = get_matrix_cache(&node->node);
     Vec3f translation;
 
     vec3s_to_vec3f(translation, node->translation);
-    mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!use_cached_matrix(cache, translation, gVec3sZero, gVec3fOne, TRUE)) {
+        mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    }
 
-    inc_mat_stack();
+    push_matrix(cache);
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -651,9 +945,13 @@ void geo_process_translation(struct GraphNodeTranslation *node) {
  * For the rest it acts as a normal display list node.
  */
 void geo_process_rotation(struct GraphNodeRotation *node) {
-    mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    struct MatrixCache *cache = get_matrix_cache(&node->node);
 
-    inc_mat_stack();
+    if (!use_cached_matrix(cache, gVec3fZero, node->rotation, gVec3fOne, TRUE)) {
+        mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    }
+
+    push_matrix(cache);
     append_dl_and_return(((struct GraphNodeDisplayList *)node));
 }
 
@@ -663,12 +961,15 @@ void geo_process_rotation(struct GraphNodeRotation *node) {
  * For the rest it acts as a normal display list node.
  */
 void geo_process_scale(struct GraphNodeScale *node) {
+    struct MatrixCache *cache = get_matrix_cache(&node->node);
     Vec3f scaleVec;
 
     vec3f_set(scaleVec, node->scale, node->scale, node->scale);
-    mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
+    if (!use_cached_matrix(cache, gVec3fZero, gVec3sZero, scaleVec, TRUE)) {
+        mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
+    }
 
-    inc_mat_stack();
+    push_matrix(cache);
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -762,6 +1063,89 @@ void geo_process_background(struct GraphNodeBackground *node) {
     }
 }
 
+/**
+ * Read the next value of the current animation.
+ */
+static ALWAYS_INLINE s16 next_anim_value(void) {
+    if (gCurrAnimPose != NULL) {
+        return *gCurrAnimPose++;
+    }
+    return gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+}
+
+/**
+ * Skip over (or back, if negative) values of the current animation.
+ */
+static ALWAYS_INLINE void skip_anim_values(s32 count) {
+    if (gCurrAnimPose != NULL) {
+        gCurrAnimPose += count;
+    } else {
+        gCurrAnimAttribute += (count * 2);
+    }
+}
+
+#ifdef ANIMATION_POSE_CACHE
+#define ANIM_POSE_CACHE_PROBES 8
+
+/**
+ * The values of an animation at one frame, decoded once and shared by everything drawn with it in the
+ * same frame. Entries from previous frames are empty, since the poses are in the display list pool.
+ */
+struct AnimPoseCacheEntry {
+    struct Animation *anim;
+    s16 frame;
+    u32 generation;
+    s16 *pose;
+};
+
+static struct AnimPoseCacheEntry sAnimPoseCache[ANIMATION_POSE_CACHE];
+static u32 sAnimPoseCacheGeneration = 1;
+
+/**
+ * Decode every value of an animation at a frame, in the order geo_process_animated_part reads them.
+ */
+static s16 *decode_animation_pose(struct Animation *anim, s16 frame, s32 numValues) {
+    s16 *pose = alloc_display_list(numValues * sizeof(s16));
+
+    if (pose != NULL) {
+        u16 *attribute = segmented_to_virtual((void *) anim->index);
+        s16 *data = segmented_to_virtual((void *) anim->values);
+
+        for (s32 i = 0; i < numValues; i++) {
+            pose[i] = data[retrieve_animation_index(frame, &attribute)];
+        }
+    }
+    return pose;
+}
+
+/**
+ * Get the values of an animation at a frame, decoding them if nothing has used them yet this frame.
+ * Returns NULL if the pose can't be cached, in which case the values are read from the animation as usual.
+ */
+static s16 *get_animation_pose(struct Animation *anim, s16 frame, s32 numValues) {
+    u32 hash = ((((uintptr_t) anim >> 2) + frame) * 2654435761U) >> 16;
+
+    for (s32 i = 0; i < ANIM_POSE_CACHE_PROBES; i++) {
+        struct AnimPoseCacheEntry *entry = &sAnimPoseCache[(hash + i) % ANIMATION_POSE_CACHE];
+
+        if (entry->generation != sAnimPoseCacheGeneration) {
+            entry->pose = decode_animation_pose(anim, frame, numValues);
+            if (entry->pose == NULL) {
+                return NULL;
+            }
+            entry->anim = anim;
+            entry->frame = frame;
+            entry->generation = sAnimPoseCacheGeneration;
+            return entry->pose;
+        }
+        if (entry->anim == anim && entry->frame == frame) {
+            return entry->pose;
+        }
+    }
+    return NULL;
+}
+#endif
+
 /**
  * Render an animated part. The current animation state is not part of the node
  * but set in global variables. If an animated part is skipped, everything afterwards desyncs.
@@ -771,42 +1155,33 @@ void geo_process_animated_part(struct GraphNodeAnimatedPart *node) {
     Vec3f translation = { node->translation[0], node->translation[1], node->translation[2] };
 
     if (gCurrAnimType == ANIM_TYPE_TRANSLATION) {
-        translation[0] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                          * gCurrAnimTranslationMultiplier;
-        translation[1] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                          * gCurrAnimTranslationMultiplier;
-        translation[2] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                          * gCurrAnimTranslationMultiplier;
+        translation[0] += next_anim_value() * gCurrAnimTranslationMultiplier;
+        translation[1] += next_anim_value() * gCurrAnimTranslationMultiplier;
+        translation[2] += next_anim_value() * gCurrAnimTranslationMultiplier;
         gCurrAnimType = ANIM_TYPE_ROTATION;
     } else {
         if (gCurrAnimType == ANIM_TYPE_LATERAL_TRANSLATION) {
-            translation[0] +=
-                gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                * gCurrAnimTranslationMultiplier;
-            gCurrAnimAttribute += 2;
-            translation[2] +=
-                gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                * gCurrAnimTranslationMultiplier;
+            translation[0] += next_anim_value() * gCurrAnimTranslationMultiplier;
+            skip_anim_values(1);
+            translation[2] += next_anim_value() * gCurrAnimTranslationMultiplier;
             gCurrAnimType = ANIM_TYPE_ROTATION;
         } else {
             if (gCurrAnimType == ANIM_TYPE_VERTICAL_TRANSLATION) {
-                gCurrAnimAttribute += 2;
-                translation[1] +=
-                    gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                    * gCurrAnimTranslationMultiplier;
-                gCurrAnimAttribute += 2;
+                skip_anim_values(1);
+                translation[1] += next_anim_value() * gCurrAnimTranslationMultiplier;
+                skip_anim_values(1);
                 gCurrAnimType = ANIM_TYPE_ROTATION;
             } else if (gCurrAnimType == ANIM_TYPE_NO_TRANSLATION) {
-                gCurrAnimAttribute += 6;
+                skip_anim_values(3);
                 gCurrAnimType = ANIM_TYPE_ROTATION;
             }
         }
     }
 
     if (gCurrAnimType == ANIM_TYPE_ROTATION) {
-        rotation[0] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
-        rotation[1] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
-        rotation[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+        rotation[0] = next_anim_value();
+        rotation[1] = next_anim_value();
+        rotation[2] = next_anim_value();
     }
 
     mtxf_rotate_xyz_and_translate_and_mul(rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
@@ -840,6 +1215,20 @@ void geo_set_animation_globals(struct AnimInfo *node, s32 hasAnimation) {
     gCurrAnimEnabled = (anim->flags & ANIM_FLAG_DISABLED) == 0;
     gCurrAnimAttribute = segmented_to_virtual((void *) anim->index);
     gCurrAnimData = segmented_to_virtual((void *) anim->values);
+    gCurrAnimPose = NULL;
+
+    // A translation and a rotation for the root, and a rotation for every other part.
+    s32 numValues = ((anim->unusedBoneCount + 1) * 3);
+    if (anim->flags & ANIM_FLAG_BAKED) {
+        // Every frame is stored in full, so the pose can be read straight from the animation.
+        s32 frame = CLAMP(gCurrAnimFrame, 0, ((s32) anim->length - 1));
+        gCurrAnimPose = (gCurrAnimData + (frame * numValues));
+    }
+#ifdef ANIMATION_POSE_CACHE
+    else if (anim->unusedBoneCount > 0) {
+        gCurrAnimPose = get_animation_pose(anim, gCurrAnimFrame, numValues);
+    }
+#endif
 
     if (anim->animYTransDivisor == 0) {
         gCurrAnimTranslationMultiplier = 1.0f;
@@ -881,11 +1270,11 @@ void geo_process_shadow(struct GraphNodeShadow *node) {
 
             f32 animScale = gCurrAnimTranslationMultiplier * objScale;
             Vec3f animOffset;
-            animOffset[0] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)] * animScale;
+            animOffset[0] = next_anim_value() * animScale;
             animOffset[1] = 0.0f;
-            gCurrAnimAttribute += 2;
-            animOffset[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)] * animScale;
-            gCurrAnimAttribute -= 6;
+            skip_anim_values(1);
+            animOffset[2] = next_anim_value() * animScale;
+            skip_anim_values(-3);
 
             // simple matrix rotation so the shadow offset rotates along with the object
             f32 sinAng = sins(gCurGraphNodeObject->angle[1]);
@@ -1002,6 +1391,86 @@ s32 obj_is_in_view(struct GraphNodeObject *node) {
     return TRUE;
 }
 
+// How many culling boxes around the current node are entirely in view, so that the ones inside them don't need testing.
+static s32 sNumCullingBoxesInView = 0;
+
+/**
+ * Transform the half extents of a box by the rotation and scale of a matrix, giving the
+ * half extents of a box around the result.
+ */
+static void transform_box_extents(Vec3f dest, Mat4 mtx, Vec3f extents) {
+    for (s32 i = 0; i < 3; i++) {
+        dest[i] = (absf(mtx[0][i]) * extents[0])
+                + (absf(mtx[1][i]) * extents[1])
+                + (absf(mtx[2][i]) * extents[2]);
+    }
+}
+
+/**
+ * Process a culling box node. The box is transformed into view space, and its children are
+ * skipped if it's entirely behind the camera, past the far plane or off the side of the screen.
+ */
+void geo_process_culling_box(struct GraphNodeCullingBox *node) {
+    s32 entirelyInView = TRUE;
+
+    if (node->node.children == NULL) {
+        return;
+    }
+
+#ifndef CULLING_ON_EMULATOR
+    // If an emulator is detected, don't cull, as with objects.
+    if (!(gEmulator & NO_CULLING_EMULATOR_BLACKLIST)) {
+        geo_process_node_and_siblings(node->node.children);
+        return;
+    }
+#endif
+
+    if (gCurGraphNodeCamFrustum != NULL && sNumCullingBoxesInView == 0) {
+        Vec3f center, extents, worldCenter, worldExtents;
+
+        vec3_sum(center, node->min, node->max);
+        vec3_scale(center, 0.5f);
+        vec3_diff(extents, node->max, node->min);
+        vec3_scale(extents, 0.5f);
+
+        // Local space to world space, then to view space.
+        linear_mtxf_mul_vec3f_and_translate(gMatStack[gMatStackIndex], worldCenter, center);
+        transform_box_extents(worldExtents, gMatStack[gMatStackIndex], extents);
+        linear_mtxf_mul_vec3f_and_translate(gCameraTransform, center, worldCenter);
+        transform_box_extents(extents, gCameraTransform, worldExtents);
+
+        // The camera looks down -Z.
+        f32 nearDepth = (-center[2] - extents[2]);
+        f32 farDepth  = (-center[2] + extents[2]);
+        if (farDepth < gCurGraphNodeCamFrustum->near || nearDepth > gCurGraphNodeCamFrustum->far) {
+            return;
+        }
+
+        // The box is off the side of the screen if even its nearest corner to the edge is outside.
+        f32 hScreenEdge = (gCurGraphNodeCamFrustum->halfFovHorizontal * farDepth);
+        if (absf(center[0]) - extents[0] > hScreenEdge) {
+            return;
+        }
+        entirelyInView = (nearDepth >= gCurGraphNodeCamFrustum->near && farDepth <= gCurGraphNodeCamFrustum->far
+                  && absf(center[0]) + extents[0] <= gCurGraphNodeCamFrustum->halfFovHorizontal * nearDepth);
+#ifdef VERTICAL_CULLING
+        f32 vScreenEdge = (gCurGraphNodeCamFrustum->halfFovVertical * farDepth);
+        if (absf(center[1]) - extents[1] > vScreenEdge) {
+            return;
+        }
+        entirelyInView &= (absf(center[1]) + extents[1] <= gCurGraphNodeCamFrustum->halfFovVertical * nearDepth);
+#endif
+    }
+
+    if (entirelyInView) {
+        sNumCullingBoxesInView++;
+        geo_process_node_and_siblings(node->node.children);
+        sNumCullingBoxesInView--;
+    } else {
+        geo_process_node_and_siblings(node->node.children);
+    }
+}
+
 #ifdef VISUAL_DEBUG
 void visualise_object_hitbox(struct Object *node) {
     Vec3f bnds1, bnds2;
@@ -1039,6 +1508,7 @@ void geo_process_object(struct Object *node) {
     if (node->header.gfx.areaIndex == gCurGraphNodeRoot->areaIndex) {
         s32 isInvisible = (node->header.gfx.node.flags & GRAPH_RENDER_INVISIBLE);
         s32 noThrowMatrix = (node->header.gfx.throwMatrix == NULL);
+        struct MatrixCache *cache = NULL;
         // Maintain throw matrix pointer if the game is paused as it won't be updated.
         Mat4 *oldThrowMatrix = (sCurrPlayMode == PLAY_MODE_PAUSED) ? node->header.gfx.throwMatrix : NULL;
 
@@ -1055,8 +1525,12 @@ void geo_process_object(struct Object *node) {
                 mtxf_billboard(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex],
                             node->header.gfx.pos, node->header.gfx.scale, gCurGraphNodeCamera->roll);
             } else {
-                mtxf_rotate_zxy_and_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos, node->header.gfx.angle);
-                mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex + 1], node->header.gfx.scale);
+                // Only the plain position, angle and scale case is cached, since the other two change with the camera or animation.
+                cache = get_matrix_cache(&node->header.gfx.node);
+                if (!use_cached_matrix(cache, node->header.gfx.pos, node->header.gfx.angle, node->header.gfx.scale, FALSE)) {
+                    mtxf_rotate_zxy_and_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos, node->header.gfx.angle);
+                    mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex + 1], node->header.gfx.scale);
+                }
             }
         }
 
@@ -1070,7 +1544,7 @@ void geo_process_object(struct Object *node) {
 
         if (!isInvisible && obj_is_in_view(&node->header.gfx)) {
             gMatStackIndex--;
-            inc_mat_stack();
+            push_matrix(cache);
 
             if (node->header.gfx.sharedChild != NULL) {
 #ifdef VISUAL_DEBUG
@@ -1145,6 +1619,7 @@ void geo_process_held_object(struct GraphNodeHeldObject *node) {
         gGeoTempState.translationMultiplier = gCurrAnimTranslationMultiplier;
         gGeoTempState.attribute = gCurrAnimAttribute;
         gGeoTempState.data = gCurrAnimData;
+        gGeoTempState.pose = gCurrAnimPose;
         gCurrAnimType = ANIM_TYPE_NONE;
         gCurGraphNodeHeldObject = (void *) node;
         if (node->objNode->header.gfx.animInfo.curAnim != NULL) {
@@ -1159,6 +1634,7 @@ void geo_process_held_object(struct GraphNodeHeldObject *node) {
         gCurrAnimTranslationMultiplier = gGeoTempState.translationMultiplier;
         gCurrAnimAttribute = gGeoTempState.attribute;
         gCurrAnimData = gGeoTempState.data;
+        gCurrAnimPose = gGeoTempState.pose;
         gMatStackIndex--;
     }
 
@@ -1202,6 +1678,7 @@ static GeoProcessFunc GeoProcessJumpTable[] = {
     [GRAPH_NODE_TYPE_CULLING_RADIUS      ] = geo_try_process_children,
     [GRAPH_NODE_TYPE_ROOT                ] = geo_try_process_children,
     [GRAPH_NODE_TYPE_START               ] = geo_try_process_children,
+    [GRAPH_NODE_TYPE_CULLING_BOX         ] = geo_process_culling_box,
 };
 
 /**
@@ -1252,6 +1729,10 @@ void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor)
 
         gMatStackIndex = 0;
         gCurrAnimType = ANIM_TYPE_NONE;
+#ifdef ANIMATION_POSE_CACHE
+        // Poses decoded in previous frames were in their display list pools.
+        sAnimPoseCacheGeneration++;
+#endif
         vec3s_set(viewport->vp.vtrans, node->x * 4, node->y * 4, 511);
         vec3s_set(viewport->vp.vscale, node->width * 4, node->height * 4, 511);
 
@@ -1269,6 +1750,10 @@ void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor)
         mtxf_identity(gMatStack[gMatStackIndex]);
         mtxf_to_mtx(initialMatrix, gMatStack[gMatStackIndex]);
         gMatStackFixed[gMatStackIndex] = initialMatrix;
+#ifdef MATRIX_CACHE_SIZE
+        // The root matrix is always the identity, so it always has the same version.
+        sMatStackVersions[gMatStackIndex] = 1;
+#endif
         gSPViewport(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(viewport));
         gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(gMatStackFixed[gMatStackIndex]),
                   G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH);
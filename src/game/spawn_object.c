@@ -5,6 +5,7 @@
 #include "engine/graph_node.h"
 #include "engine/math_util.h"
 #include "engine/surface_collision.h"
+#include "engine/surface_load.h"
 #include "level_table.h"
 #include "object_constants.h"
 #include "object_fields.h"
@@ -96,6 +97,9 @@ void unload_object(struct Object *obj) {
     obj->oFloor = NULL;
 
     obj->header.gfx.throwMatrix = NULL;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    unload_object_surfaces(obj);
+#endif
     stop_sounds_from_source(obj->header.gfx.cameraToObject);
     geo_remove_child(&obj->header.gfx.node);
     geo_add_child(&gObjParentGraphNode, &obj->header.gfx.node);
@@ -158,6 +162,7 @@ struct Object *allocate_object(struct ObjectNode *objList) {
     }
 #endif
 
+    obj->framesSkipped = 0;
     obj->unused1 = 0;
     obj->bhvStackIndex = 0;
     obj->bhvDelayTimer = 0;
@@ -167,7 +172,7 @@ struct Object *allocate_object(struct ObjectNode *objList) {
     obj->hurtboxRadius = 0.0f;
     obj->hurtboxHeight = 0.0f;
     obj->hitboxDownOffset = 0.0f;
-    obj->unused2 = 0;
+    obj->nativeLoop = NULL;
 
     obj->platform = NULL;
     obj->collisionData = NULL;
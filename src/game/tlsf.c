@@ -0,0 +1,283 @@
+#include <PR/ultratypes.h>
+
+#include "sm64.h"
+#include "debug.h"
+#include "memory.h"
+#include "puppyprint.h"
+
+/**
+ * A two-level segregated fit (TLSF) allocator, carved out of the main pool.
+ *
+ * Unlike the main pool, blocks can be allocated and freed in any order, and unlike mem_pool_*, neither
+ * takes longer the more blocks there are. Free blocks are kept in lists by size: the first level splits
+ * sizes by powers of two, and the second level splits each of those into TLSF_SL_COUNT equal ranges.
+ * A bitmap for each level finds the first non-empty list that's large enough without searching.
+ * Freed blocks are merged with their free neighbours straight away.
+ *
+ * Every block starts with an 8 byte header. The block before it in memory is always known, so that
+ * a freed block can be merged backwards. Free blocks also hold their free list links.
+ */
+
+#define TLSF_ALIGN          8
+#define TLSF_ALIGN_LOG2     3
+#define TLSF_SL_COUNT_LOG2  4
+#define TLSF_SL_COUNT       (1 << TLSF_SL_COUNT_LOG2)
+// Blocks smaller than this all go in the first level, in steps of TLSF_ALIGN.
+#define TLSF_FL_SHIFT       (TLSF_SL_COUNT_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_BLOCK    (1 << TLSF_FL_SHIFT)
+// Pools must be smaller than 1 << (TLSF_FL_INDEX_MAX + 1) bytes.
+#define TLSF_FL_INDEX_MAX   23
+#define TLSF_FL_COUNT       (TLSF_FL_INDEX_MAX - TLSF_FL_SHIFT + 2)
+
+#define TLSF_BLOCK_FREE     0x1
+#define TLSF_HEADER_SIZE    offsetof(struct TlsfBlock, nextFree)
+#define TLSF_MIN_BLOCK      sizeof(struct TlsfBlock)
+
+struct TlsfBlock {
+    struct TlsfBlock *prevPhys; // The block before this one in memory
+    u32 size;                   // Including the header. The low bits are flags.
+    // Only used while the block is free:
+    struct TlsfBlock *nextFree;
+    struct TlsfBlock *prevFree;
+};
+
+struct TlsfPool {
+    u32 flBitmap;
+    u16 slBitmaps[TLSF_FL_COUNT];
+    struct TlsfBlock *freeLists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+    u32 totalSpace;
+    u32 usedSpace;
+    u32 numUsedBlocks;
+    u32 numFreeBlocks;
+};
+
+static ALWAYS_INLINE u32 tlsf_block_size(struct TlsfBlock *block) {
+    return (block->size & ~(TLSF_ALIGN - 1));
+}
+
+static ALWAYS_INLINE struct TlsfBlock *tlsf_next_block(struct TlsfBlock *block) {
+    return (struct TlsfBlock *) ((u8 *) block + tlsf_block_size(block));
+}
+
+/**
+ * Index of the highest set bit.
+ */
+static ALWAYS_INLINE s32 tlsf_fls(u32 word) {
+    return (31 - __builtin_clz(word));
+}
+
+/**
+ * Index of the lowest set bit.
+ */
+static ALWAYS_INLINE s32 tlsf_ffs(u32 word) {
+    return tlsf_fls(word & -word);
+}
+
+/**
+ * Get the free list that holds blocks of this size.
+ */
+static void tlsf_mapping(u32 size, s32 *fl, s32 *sl) {
+    if (size < TLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = (size >> TLSF_ALIGN_LOG2);
+    } else {
+        s32 bit = tlsf_fls(size);
+        *sl = ((size >> (bit - TLSF_SL_COUNT_LOG2)) ^ TLSF_SL_COUNT);
+        *fl = (bit - (TLSF_FL_SHIFT - 1));
+    }
+}
+
+/**
+ * Get the smallest block size that goes in this free list.
+ */
+static u32 tlsf_list_min_size(s32 fl, s32 sl) {
+    if (fl == 0) {
+        return (sl << TLSF_ALIGN_LOG2);
+    }
+    return ((TLSF_SL_COUNT + sl) << (fl + TLSF_FL_SHIFT - 1 - TLSF_SL_COUNT_LOG2));
+}
+
+static void tlsf_insert_free_block(struct TlsfPool *pool, struct TlsfBlock *block) {
+    s32 fl, sl;
+
+    tlsf_mapping(tlsf_block_size(block), &fl, &sl);
+    block->size |= TLSF_BLOCK_FREE;
+    block->prevFree = NULL;
+    block->nextFree = pool->freeLists[fl][sl];
+    if (block->nextFree != NULL) {
+        block->nextFree->prevFree = block;
+    }
+    pool->freeLists[fl][sl] = block;
+    pool->flBitmap |= BIT(fl);
+    pool->slBitmaps[fl] |= BIT(sl);
+    pool->numFreeBlocks++;
+}
+
+static void tlsf_remove_free_block(struct TlsfPool *pool, struct TlsfBlock *block) {
+    s32 fl, sl;
+
+    tlsf_mapping(tlsf_block_size(block), &fl, &sl);
+    if (block->prevFree != NULL) {
+        block->prevFree->nextFree = block->nextFree;
+    } else {
+        pool->freeLists[fl][sl] = block->nextFree;
+        if (block->nextFree == NULL) {
+            pool->slBitmaps[fl] &= ~BIT(sl);
+            if (pool->slBitmaps[fl] == 0) {
+                pool->flBitmap &= ~BIT(fl);
+            }
+        }
+    }
+    if (block->nextFree != NULL) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+    block->size &= ~TLSF_BLOCK_FREE;
+    pool->numFreeBlocks--;
+}
+
+/**
+ * Find a free block of at least this size, or NULL if there isn't one.
+ */
+static struct TlsfBlock *tlsf_find_free_block(struct TlsfPool *pool, u32 size) {
+    s32 fl, sl;
+
+    // Round up to the next list, so that any block in it is large enough.
+    if (size >= TLSF_SMALL_BLOCK) {
+        size += (1 << (tlsf_fls(size) - TLSF_SL_COUNT_LOG2)) - 1;
+    }
+    tlsf_mapping(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT) {
+        return NULL;
+    }
+
+    u32 slMap = (pool->slBitmaps[fl] & (~0U << sl));
+    if (slMap == 0) {
+        u32 flMap = (pool->flBitmap & (~0U << (fl + 1)));
+        if (flMap == 0) {
+            return NULL;
+        }
+        fl = tlsf_ffs(flMap);
+        slMap = pool->slBitmaps[fl];
+    }
+    return pool->freeLists[fl][tlsf_ffs(slMap)];
+}
+
+/**
+ * Allocate a TLSF pool from the main pool.
+ * Return NULL if there is not enough space in the main pool.
+ */
+struct TlsfPool *tlsf_pool_init(u32 size, u32 side) {
+    struct TlsfPool *pool;
+
+    size = ALIGN8(size);
+    assert(size < (1U << (TLSF_FL_INDEX_MAX + 1)), "TLSF pool is too large.");
+    // Room for the pool, and the empty block that marks the end of it.
+    pool = main_pool_alloc(ALIGN8(sizeof(struct TlsfPool)) + size + TLSF_HEADER_SIZE, side);
+    if (pool != NULL) {
+        bzero(pool, sizeof(struct TlsfPool));
+        pool->totalSpace = size;
+
+        struct TlsfBlock *block = (struct TlsfBlock *) ((u8 *) pool + ALIGN8(sizeof(struct TlsfPool)));
+        block->prevPhys = NULL;
+        block->size = size;
+
+        struct TlsfBlock *end = tlsf_next_block(block);
+        end->prevPhys = block;
+        end->size = 0;
+
+        tlsf_insert_free_block(pool, block);
+#ifdef PUPPYPRINT_DEBUG
+        gPoolMem += ALIGN16(ALIGN8(sizeof(struct TlsfPool)) + size + TLSF_HEADER_SIZE) + 16;
+#endif
+    }
+    return pool;
+}
+
+/**
+ * Allocate from a TLSF pool. Return NULL if there is not enough space.
+ * Blocks are 8 byte aligned.
+ */
+void *tlsf_pool_alloc(struct TlsfPool *pool, u32 size) {
+    size = (ALIGN8(size) + TLSF_HEADER_SIZE);
+    if (size < TLSF_MIN_BLOCK) {
+        size = TLSF_MIN_BLOCK;
+    }
+
+    struct TlsfBlock *block = tlsf_find_free_block(pool, size);
+    if (block == NULL) {
+        return NULL;
+    }
+    tlsf_remove_free_block(pool, block);
+
+    // Give back whatever isn't needed, if it's large enough to be a block by itself.
+    u32 remaining = (tlsf_block_size(block) - size);
+    if (remaining >= TLSF_MIN_BLOCK) {
+        struct TlsfBlock *rest = (struct TlsfBlock *) ((u8 *) block + size);
+        rest->prevPhys = block;
+        rest->size = remaining;
+        tlsf_next_block(rest)->prevPhys = rest;
+        block->size = size;
+        tlsf_insert_free_block(pool, rest);
+    }
+
+    pool->usedSpace += tlsf_block_size(block);
+    pool->numUsedBlocks++;
+    return ((u8 *) block + TLSF_HEADER_SIZE);
+}
+
+/**
+ * Free a block that was allocated using tlsf_pool_alloc.
+ */
+void tlsf_pool_free(struct TlsfPool *pool, void *addr) {
+    struct TlsfBlock *block = (struct TlsfBlock *) ((u8 *) addr - TLSF_HEADER_SIZE);
+    struct TlsfBlock *prev = block->prevPhys;
+    struct TlsfBlock *next = tlsf_next_block(block);
+
+    assert(!(block->size & TLSF_BLOCK_FREE), "Freed a TLSF block twice.");
+    pool->usedSpace -= tlsf_block_size(block);
+    pool->numUsedBlocks--;
+
+    if (prev != NULL && (prev->size & TLSF_BLOCK_FREE)) {
+        tlsf_remove_free_block(pool, prev);
+        prev->size += tlsf_block_size(block);
+        block = prev;
+    }
+    if (next->size & TLSF_BLOCK_FREE) {
+        tlsf_remove_free_block(pool, next);
+        block->size += tlsf_block_size(next);
+    }
+    tlsf_next_block(block)->prevPhys = block;
+    tlsf_insert_free_block(pool, block);
+}
+
+/**
+ * Fill in how much of a TLSF pool is in use, and how fragmented the rest of it is.
+ */
+void tlsf_pool_get_stats(struct TlsfPool *pool, struct TlsfPoolStats *stats) {
+    stats->totalSpace = pool->totalSpace;
+    stats->usedSpace = pool->usedSpace;
+    stats->numUsedBlocks = pool->numUsedBlocks;
+    stats->numFreeBlocks = pool->numFreeBlocks;
+    stats->largestFreeBlock = 0;
+    u32 largestBlock = 0;
+
+    // The largest free block is in the highest non-empty list.
+    if (pool->flBitmap != 0) {
+        s32 fl = tlsf_fls(pool->flBitmap);
+        s32 sl = tlsf_fls(pool->slBitmaps[fl]);
+        struct TlsfBlock *block = pool->freeLists[fl][sl];
+        for (; block != NULL; block = block->nextFree) {
+            if (tlsf_block_size(block) > largestBlock) {
+                largestBlock = tlsf_block_size(block);
+            }
+        }
+
+        // tlsf_find_free_block rounds requests up to the next list, so the largest block that can be
+        // allocated is the smallest size in that list, even if the blocks in it are larger.
+        stats->largestFreeBlock = (tlsf_list_min_size(fl, sl) - TLSF_HEADER_SIZE);
+    }
+
+    // How much of the free space isn't in the largest free block, in percent.
+    u32 freeSpace = (pool->totalSpace - pool->usedSpace);
+    stats->fragmentation = (freeSpace != 0) ? (100 - ((u64) largestBlock * 100 / freeSpace)) : 0;
+}
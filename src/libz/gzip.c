@@ -1,10 +1,13 @@
-#include "zlib.h"
+#include "zutil.h"
+#include "inftrees.h"
+#include "inflate.h"
 
 /*
  * Local functions for allocating memory
  *
- * Since expand_gzip is only used for one shot inflation, the only memory needing to
- * be allocated is one copy of inflate_state, which in the current compilation is 7080 bytes
+ * Since expand_gzip is only used for one shot inflation, and the streamed version
+ * uses its output buffer as the window, the only memory needing to be allocated
+ * is one copy of inflate_state, which in the current compilation is 7080 bytes
  */
 #define GZIP_MEM_SIZE 8000
 static char gzip_mem[GZIP_MEM_SIZE];
@@ -72,3 +75,77 @@ expand_gzip(char *in, char *outbuf, unsigned int inLength, unsigned int outbufLe
     return d_stream.total_out;
 
 }
+
+/*
+ * Streamed inflation, for when the input arrives a piece at a time.
+ * Only one stream can be inflated at once.
+ */
+static z_stream stream_d_stream;
+
+/*
+ * Start inflating into outbuf. Returns Z_OK or a -ve value for error.
+ */
+int
+expand_gzip_stream_start(char *outbuf, unsigned int outbufLength)
+{
+    int err;
+
+    stream_d_stream.zalloc = (alloc_func) myalloc;
+    stream_d_stream.zfree = (free_func) myfree;
+    stream_d_stream.opaque = (voidpf)0;
+
+    stream_d_stream.next_in  = Z_NULL;
+    stream_d_stream.avail_in = 0;
+    stream_d_stream.next_out = outbuf;
+    stream_d_stream.avail_out = outbufLength;
+
+    err = inflateInit2(&stream_d_stream, -MAX_WBITS);
+    if (err != Z_OK) {
+        return err;
+    }
+
+    /*
+     * All of the output stays in outbuf, so matches can be copied from there
+     * instead of from a 32K window that every call would have to update
+     */
+    ((struct inflate_state FAR *)stream_d_stream.state)->outStart = (unsigned char FAR *)outbuf;
+
+    return Z_OK;
+}
+
+/*
+ * Inflate the next inLength bytes of input, all of which are consumed.
+ * Returns Z_OK if more input is needed, Z_STREAM_END once all of the output
+ * has been written, or a -ve value for error.
+ */
+int
+expand_gzip_stream(char *in, unsigned int inLength)
+{
+    int err;
+
+    stream_d_stream.next_in  = in;
+    stream_d_stream.avail_in = inLength;
+
+    err = inflate(&stream_d_stream, Z_NO_FLUSH);
+    if (err == Z_BUF_ERROR && stream_d_stream.avail_out != 0) {
+        return Z_OK;
+    }
+
+    return err;
+}
+
+/*
+ * Finish a stream. Returns -ve value for error, or number of output bytes for success
+ */
+int
+expand_gzip_stream_end(void)
+{
+    int err;
+
+    err = inflateEnd(&stream_d_stream);
+    if (err != Z_OK) {
+        return err;
+    }
+
+    return stream_d_stream.total_out;
+}
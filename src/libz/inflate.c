@@ -114,6 +114,7 @@ z_streamp strm;
     state->havedict = 0;
     state->wsize = 0;
     state->whave = 0;
+    state->outStart = Z_NULL;
     state->hold = 0;
     state->bits = 0;
     state->lencode = state->distcode = state->next = state->codes;
@@ -309,6 +310,15 @@ unsigned out;
 
     state = (struct inflate_state FAR *)strm->state;
 
+    /* if all output so far is still in one buffer, use it as the window in
+       place: with write == wsize, matches are copied from next_out - dist */
+    if (state->outStart != Z_NULL) {
+        state->window = state->outStart;
+        state->wsize = state->whave = state->write =
+            (unsigned)(strm->next_out - state->outStart);
+        return 0;
+    }
+
     /* if it hasn't been done already, allocate space for the window */
     if (state->window == Z_NULL) {
         state->window = (unsigned char FAR *)
@@ -1088,7 +1098,8 @@ z_streamp strm;
     if (strm == Z_NULL || strm->state == Z_NULL || strm->zfree == (free_func)0)
         return Z_STREAM_ERROR;
     state = (struct inflate_state FAR *)strm->state;
-    if (state->window != Z_NULL) ZFREE(strm, state->window);
+    if (state->window != Z_NULL && state->window != state->outStart)
+        ZFREE(strm, state->window);
     ZFREE(strm, strm->state);
     strm->state = Z_NULL;
     Tracev((stderr, "inflate: end\n"));
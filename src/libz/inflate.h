@@ -92,6 +92,8 @@ struct inflate_state {
     unsigned whave;             /* valid bytes in the window */
     unsigned write;             /* window write index */
     unsigned char FAR *window;  /* allocated sliding window, if needed */
+    unsigned char FAR *outStart; /* start of contiguous output to use as the
+                                    window, or Z_NULL to allocate one */
         /* bit accumulator */
     unsigned long hold;         /* input bit accumulator */
     unsigned bits;              /* number of bits in "in" */
@@ -0,0 +1,237 @@
+/**
+ * Headless audio renderer.
+ *
+ * Runs the game's audio driver (src/audio) on the host the way the sound thread runs it:
+ * once per video frame it creates the audio task, which is run straight away through the
+ * microcode emulator in rsp_audio.c, and the audio interface model plays the buffers the task
+ * produced two frames earlier into a WAV file.
+ *
+ * Besides the WAV it reports how long the audio code took per audio frame, per audio update and
+ * per synthesis_process_notes call, and how long each of the audio profiler's sections took.
+ * These are host cycles: use them to compare two builds of the audio code with each other on
+ * the same machine, not as VR4300 timings.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <ultra64.h>
+#include "seq_ids.h"
+#include "audio/data.h"
+#include "audio/external.h"
+#include "audio/heap.h"
+#include "audio/internal.h"
+#include "audio/load.h"
+#include "game/emutest.h"
+#include "game/profiling.h"
+
+#include "audio_render.h"
+
+#define DEFAULT_SECONDS     60
+#define DEFAULT_OUTPUT      "out.wav"
+#define VIDEO_RATE          60
+// How long to keep rendering after the sequence ends, for its notes to release.
+#define TAIL_FRAMES         VIDEO_RATE
+
+extern u16 gSequenceCount;
+
+struct RenderStat {
+    u64 total;
+    u64 max;
+    u64 count;
+};
+
+struct RenderReport {
+    struct RenderStat cpuFrame;
+    struct RenderStat rspFrame;
+    struct RenderStat update;
+    struct RenderStat processNotes;
+    struct RenderStat commands;
+    u64 sections[RENDER_NUM_SECTIONS];
+    u32 numFrames;
+};
+
+static const char *sSectionNames[RENDER_NUM_SECTIONS] = {
+    "sequences", "  script", "  reclaim", "  processing", "synthesis", "  note processing",
+    "  envelope/reverb", "  sample dma", "outside updates",
+};
+
+static void stat_add(struct RenderStat *stat, u64 total, u64 count, u64 max) {
+    stat->total += total;
+    stat->count += count;
+    stat->max = MAX(stat->max, max);
+}
+
+static void print_stat(const char *name, struct RenderStat *stat) {
+    printf("  %-22s %12.0f avg %12llu max\n", name,
+           (stat->count != 0) ? ((f64) stat->total / stat->count) : 0.0, (unsigned long long) stat->max);
+}
+
+static void write_wav_header(FILE *file, u32 frequency, u32 numSamples) {
+    u32 dataSize = numSamples * 4;
+    u8 header[44];
+
+    // RIFF headers are little endian, like the samples written by the audio interface model.
+    memcpy(&header[0], "RIFF", 4);
+    *(u32 *) &header[4] = 36 + dataSize;
+    memcpy(&header[8], "WAVEfmt ", 8);
+    *(u32 *) &header[16] = 16;
+    *(u16 *) &header[20] = 1;             // PCM
+    *(u16 *) &header[22] = 2;             // Channels
+    *(u32 *) &header[24] = frequency;
+    *(u32 *) &header[28] = frequency * 4; // Bytes per second
+    *(u16 *) &header[32] = 4;             // Bytes per sample
+    *(u16 *) &header[34] = 16;            // Bits per channel
+    memcpy(&header[36], "data", 4);
+    *(u32 *) &header[40] = dataSize;
+
+    fseek(file, 0, SEEK_SET);
+    fwrite(header, sizeof(header), 1, file);
+}
+
+static void print_report(struct RenderReport *report, s32 seqId, const char *output) {
+    f64 seconds = (f64) gAiStats.samplesPlayed / gAiFrequency;
+
+    printf("Sequence 0x%02X: %u audio frames, %.2f s at %d Hz written to %s\n",
+           seqId, report->numFrames, seconds, gAiFrequency, output);
+    printf("Audio interface: %u buffers, %u dropped, %u underruns (%.1f ms of silence)\n",
+           gAiStats.buffersQueued, gAiStats.buffersDropped, gAiStats.underruns,
+           1000.0 * gAiStats.underrunSamples / gAiFrequency);
+    printf("Audio commands per frame: %.0f avg, %llu max\n",
+           (report->commands.count != 0) ? ((f64) report->commands.total / report->commands.count) : 0.0,
+           (unsigned long long) report->commands.max);
+    printf("\n");
+
+    printf("Host cycles:\n");
+    print_stat("audio frame (CPU)", &report->cpuFrame);
+    print_stat("audio frame (RSP emu)", &report->rspFrame);
+    print_stat("audio update", &report->update);
+    print_stat("process_notes call", &report->processNotes);
+    printf("\n");
+
+    printf("Host cycles per audio frame by profiler section:\n");
+    for (s32 i = 0; i < RENDER_NUM_SECTIONS; i++) {
+        printf("  %-22s %12.0f\n", sSectionNames[i],
+               (report->numFrames != 0) ? ((f64) report->sections[i] / report->numFrames) : 0.0);
+    }
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [options] <sequence id>\n"
+           "\n"
+           "Renders a sequence (see include/seq_ids.h) on the level music player to a WAV file,\n"
+           "until it ends or the time limit is reached.\n"
+           "\n"
+           "Options:\n"
+           "  -o <file>    output file (default %s)\n"
+           "  -t <seconds> longest time to render (default %d)\n"
+           "  -r <preset>  reverb preset passed to sound_reset (default 0)\n",
+           prog, DEFAULT_OUTPUT, DEFAULT_SECONDS);
+}
+
+int main(int argc, char **argv) {
+    const char *output = DEFAULT_OUTPUT;
+    u32 seconds = DEFAULT_SECONDS;
+    u8 reverbPreset = 0;
+    s32 opt;
+
+    while ((opt = getopt(argc, argv, "o:t:r:h")) != -1) {
+        switch (opt) {
+            case 'o': output = optarg; break;
+            case 't': seconds = strtoul(optarg, NULL, 0); break;
+            case 'r': reverbPreset = strtoul(optarg, NULL, 0); break;
+            default:
+                print_usage(argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    s32 seqId = strtol(argv[optind], NULL, 0);
+
+    // The audio commands hold addresses in 32 bits, see Awords in PR/abi.h.
+    if ((uintptr_t) (gAudioHeap + gAudioHeapSize) > 0xFFFFFFFFU) {
+        fprintf(stderr, "The audio heap isn't in the low 4GB; build with -no-pie\n");
+        return 1;
+    }
+
+    FILE *file = fopen(output, "wb");
+    if (file == NULL) {
+        perror(output);
+        return 1;
+    }
+
+    audio_init();
+    sound_init();
+    if (seqId <= 0 || seqId >= gSequenceCount) {
+        fprintf(stderr, "There is no sequence 0x%X (the sound data has %u sequences)\n", seqId, gSequenceCount);
+        return 1;
+    }
+    // audio_reset_session spins until the sound thread finishes an audio frame, which would never
+    // happen here. Nothing is in flight between frames, so skip the wait like on Wii VC.
+    gEmulator = EMU_WIIVC;
+    sound_reset(reverbPreset);
+    gEmulator = EMU_CONSOLE;
+    play_music(SEQ_PLAYER_LEVEL, SEQUENCE_ARGS(4, seqId), 0);
+
+    write_wav_header(file, 0, 0);
+    ai_set_output(file);
+
+    struct RenderReport report;
+    bzero(&report, sizeof(report));
+    u32 maxFrames = seconds * VIDEO_RATE;
+    u32 sampleFrac = 0;
+    s32 started = FALSE;
+    s32 tailFrames = -1;
+
+    while (report.numFrames < maxFrames && tailFrames != 0) {
+        audio_signal_game_loop_tick();
+
+        render_frame_times_reset();
+        u64 start = host_cycles();
+        struct SPTask *task = create_next_audio_frame_task();
+        u64 end = host_cycles();
+        render_frame_times_finish();
+
+        if (task != NULL) {
+            u64 rspStart = host_cycles();
+            rsp_audio_run_task((u64 *) task->task.t.data_ptr, task->task.t.data_size / sizeof(u64));
+            u64 rspTime = host_cycles() - rspStart;
+            u32 numCmds = task->task.t.data_size / sizeof(u64);
+            stat_add(&report.rspFrame, rspTime, 1, rspTime);
+            stat_add(&report.commands, numCmds, 1, numCmds);
+        }
+
+        struct RenderFrameTimes *times = &gRenderFrameTimes;
+        stat_add(&report.cpuFrame, end - start, 1, end - start);
+        stat_add(&report.update, times->updateTotal, times->numUpdates, times->updateMax);
+        stat_add(&report.processNotes, times->processNotesTotal, times->numProcessNotes, times->processNotesMax);
+        for (s32 i = 0; i < RENDER_NUM_SECTIONS; i++) {
+            report.sections[i] += times->sections[i];
+        }
+        report.numFrames++;
+
+        // Play one video frame's worth of samples.
+        sampleFrac += gAiFrequency;
+        ai_advance(sampleFrac / VIDEO_RATE);
+        sampleFrac %= VIDEO_RATE;
+
+        if (gSequencePlayers[SEQ_PLAYER_LEVEL].enabled) {
+            started = TRUE;
+        } else if (started && tailFrames < 0) {
+            tailFrames = TAIL_FRAMES;
+        }
+        if (tailFrames > 0) {
+            tailFrames--;
+        }
+    }
+
+    write_wav_header(file, gAiFrequency, gAiStats.samplesPlayed);
+    fclose(file);
+
+    print_report(&report, seqId, output);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#ifndef AUDIO_RENDER_H
+#define AUDIO_RENDER_H
+
+#include <stdio.h>
+
+#include <PR/ultratypes.h>
+
+/**
+ * Host cycle counter. This is the TSC on x86 and nanoseconds elsewhere; either way it
+ * measures the host, not the VR4300, so only compare it with other runs on the same machine.
+ */
+u64 host_cycles(void);
+
+/**
+ * Host timings of one audio frame, filled in by the profiler hooks in os_stubs.c.
+ * Section times are indexed like the PROFILER_TIME_SUB_AUDIO_* entries, relative to
+ * PROFILER_TIME_SUB_AUDIO_START.
+ */
+#define RENDER_NUM_SECTIONS 9
+
+struct RenderFrameTimes {
+    u64 sections[RENDER_NUM_SECTIONS];
+    u64 updateTotal;            // Time spent in all audio updates of the frame
+    u64 updateMax;              // The longest single audio update
+    u32 numUpdates;
+    u64 processNotesTotal;      // Time spent in all synthesis_process_notes calls of the frame
+    u64 processNotesMax;        // The longest single synthesis_process_notes call
+    u32 numProcessNotes;
+};
+
+extern struct RenderFrameTimes gRenderFrameTimes;
+
+void render_frame_times_reset(void);
+void render_frame_times_finish(void);
+
+/**
+ * A model of the audio interface: the DAC plays the current buffer while one more can be queued.
+ * Played samples are written to the output file, with silence wherever the DAC ran dry.
+ */
+struct AiStats {
+    u64 samplesPlayed;          // Stereo samples, including silence from underruns
+    u64 underrunSamples;        // Samples of silence played because no buffer was queued
+    u32 underruns;
+    u32 buffersQueued;
+    u32 buffersDropped;         // osAiSetNextBuffer calls made while both buffers were in use
+};
+
+extern struct AiStats gAiStats;
+
+void ai_set_output(FILE *file);
+void ai_advance(u32 numSamples);
+
+/**
+ * Runs an audio command list on the host, the way the US audio microcode (rsp/audio.s) would.
+ */
+void rsp_audio_run_task(u64 *cmdList, u32 numCmds);
+
+#endif // AUDIO_RENDER_H
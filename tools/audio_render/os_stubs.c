@@ -0,0 +1,276 @@
+/**
+ * Stand-ins for the parts of libultra and the game that the audio code uses, so that
+ * src/audio can be linked on the host: PI DMAs are memcpys, the audio interface is a model
+ * that plays into the output file, and the audio profiler's sections are timed with the
+ * host's cycle counter.
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <ultra64.h>
+#include "types.h"
+#include "audio/data.h"
+#include "audio/heap.h"
+#include "game/area.h"
+#include "game/emutest.h"
+#include "game/level_update.h"
+#include "game/main.h"
+#include "game/object_list_processor.h"
+#include "game/profiling.h"
+
+#include "audio_render.h"
+
+/**
+ * Game state read by the audio code.
+ */
+ALIGNED16 u8 gAudioHeap[DOUBLE_SIZE_ON_64_BIT(AUDIO_HEAP_SIZE)];
+s8 gAudioEnabled = TRUE;
+struct Config gConfig = { .audioFrequency = 1.0f };
+enum Emulator gEmulator = EMU_CONSOLE;
+struct Area gAreaData[8];
+s16 gCurrAreaIndex;
+s16 gCurrLevelNum;
+s16 gMarioCurrentRoom;
+struct MarioState gMarioStates[1];
+
+// The audio code only takes the addresses of these to describe the RSP task.
+u64 rspbootTextStart[1], rspbootTextEnd[1];
+u64 aspMainTextStart[1], aspMainDataStart[1], aspMainDataEnd[1];
+
+void __n64Assert(char *fileName, u32 lineNum, char *message) {
+    fprintf(stderr, "%s:%u: %s\n", fileName, lineNum, message);
+    abort();
+}
+
+void osSyncPrintf(UNUSED const char *fmt, ...) {
+}
+
+void osInvalDCache(UNUSED void *vaddr, UNUSED s32 nbytes) {
+}
+
+void osWritebackDCache(UNUSED void *vaddr, UNUSED s32 nbytes) {
+}
+
+void osWritebackDCacheAll(void) {
+}
+
+void alSeqFileNew(ALSeqFile *file, u8 *base) {
+    for (s32 i = 0; i < file->seqCount; i++) {
+        file->seqArray[i].offset = base + (uintptr_t) file->seqArray[i].offset;
+    }
+}
+
+/**
+ * Message queues. Nothing ever waits, since every DMA has finished by the time it's queued.
+ */
+void osCreateMesgQueue(OSMesgQueue *mq, OSMesg *msg, s32 count) {
+    mq->validCount = 0;
+    mq->first = 0;
+    mq->msgCount = count;
+    mq->msg = msg;
+}
+
+static s32 send_mesg(OSMesgQueue *mq, OSMesg msg) {
+    if (mq->validCount >= mq->msgCount) {
+        return -1;
+    }
+    mq->msg[(mq->first + mq->validCount) % mq->msgCount] = msg;
+    mq->validCount++;
+    return 0;
+}
+
+s32 osRecvMesg(OSMesgQueue *mq, OSMesg *msg, s32 flag) {
+    if (mq->validCount == 0) {
+        if (flag == OS_MESG_NOBLOCK) {
+            return -1;
+        }
+        fprintf(stderr, "osRecvMesg: blocking on an empty queue would never return\n");
+        abort();
+    }
+    if (msg != NULL) {
+        *msg = mq->msg[mq->first];
+    }
+    mq->first = (mq->first + 1) % mq->msgCount;
+    mq->validCount--;
+    return 0;
+}
+
+/**
+ * The sound data is linked into the program, so "ROM" addresses are host addresses.
+ */
+s32 osPiStartDma(OSIoMesg *mb, UNUSED s32 priority, UNUSED s32 direction, u32 devAddr, void *vAddr,
+                 u32 nbytes, OSMesgQueue *mq) {
+    memcpy(vAddr, (void *) (uintptr_t) devAddr, nbytes);
+    return send_mesg(mq, (OSMesg) mb);
+}
+
+/**
+ * Audio interface.
+ */
+struct AiBuffer {
+    s16 samples[AIBUFFER_LEN / sizeof(s16)];
+    u32 numSamples; // Stereo samples
+    u32 pos;
+};
+
+struct AiStats gAiStats;
+static struct AiBuffer sAiBuffers[2];
+static s32 sAiCurrent;
+static s32 sAiNumQueued;
+static FILE *sAiOutput;
+
+s32 osAiSetFrequency(u32 frequency) {
+    // The DAC divides the video clock, so it can't hit every rate exactly.
+    u32 dacRate = (f32) VI_NTSC_CLOCK / frequency + 0.5f;
+    return (VI_NTSC_CLOCK / dacRate);
+}
+
+u32 osAiGetLength(void) {
+    if (sAiNumQueued == 0) {
+        return 0;
+    }
+    struct AiBuffer *buf = &sAiBuffers[sAiCurrent];
+    return (buf->numSamples - buf->pos) * 4;
+}
+
+s32 osAiSetNextBuffer(void *vaddr, u32 nbytes) {
+    if (sAiNumQueued == ARRAY_COUNT(sAiBuffers)) {
+        gAiStats.buffersDropped++;
+        return -1;
+    }
+
+    // Copy the samples, since the RSP is free to overwrite the buffer before it has played.
+    struct AiBuffer *buf = &sAiBuffers[(sAiCurrent + sAiNumQueued) % ARRAY_COUNT(sAiBuffers)];
+    nbytes = MIN(nbytes, sizeof(buf->samples));
+    memcpy(buf->samples, vaddr, nbytes);
+    buf->numSamples = nbytes / 4;
+    buf->pos = 0;
+    sAiNumQueued++;
+    gAiStats.buffersQueued++;
+    return 0;
+}
+
+void ai_set_output(FILE *file) {
+    sAiOutput = file;
+}
+
+/**
+ * Play this many stereo samples.
+ */
+void ai_advance(u32 numSamples) {
+    static s16 sSilence[AIBUFFER_LEN / sizeof(s16)];
+    static s32 sStarved = FALSE;
+
+    // Nothing is played until the first buffer arrives.
+    if (gAiStats.buffersQueued == 0) {
+        return;
+    }
+
+    while (numSamples != 0) {
+        if (sAiNumQueued == 0) {
+            u32 count = MIN(numSamples, ARRAY_COUNT(sSilence) / 2);
+            if (!sStarved) {
+                gAiStats.underruns++;
+                sStarved = TRUE;
+            }
+            fwrite(sSilence, 4, count, sAiOutput);
+            gAiStats.underrunSamples += count;
+            gAiStats.samplesPlayed += count;
+            numSamples -= count;
+            continue;
+        }
+
+        struct AiBuffer *buf = &sAiBuffers[sAiCurrent];
+        u32 count = MIN(numSamples, buf->numSamples - buf->pos);
+        sStarved = FALSE;
+        fwrite(&buf->samples[buf->pos * 2], 4, count, sAiOutput);
+        buf->pos += count;
+        gAiStats.samplesPlayed += count;
+        numSamples -= count;
+
+        if (buf->pos == buf->numSamples) {
+            sAiCurrent = (sAiCurrent + 1) % ARRAY_COUNT(sAiBuffers);
+            sAiNumQueued--;
+        }
+    }
+}
+
+/**
+ * Profiler hooks. These keep the same per-section tallies as the audio profiler in
+ * profiling.h, and additionally time each audio update and each synthesis_process_notes call.
+ */
+STATIC_ASSERT(RENDER_NUM_SECTIONS == PROFILER_TIME_SUB_AUDIO_END - PROFILER_TIME_SUB_AUDIO_START,
+              "RENDER_NUM_SECTIONS doesn't match the audio profiler");
+
+#define SECTION(name) (PROFILER_TIME_SUB_AUDIO_##name - PROFILER_TIME_SUB_AUDIO_START)
+
+struct RenderFrameTimes gRenderFrameTimes;
+static u64 sSectionStarts[RENDER_NUM_SECTIONS];
+static u64 sUpdateStart;
+static u64 sProcessNotesStart;
+
+u64 host_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((u64) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+#endif
+}
+
+void render_frame_times_reset(void) {
+    bzero(&gRenderFrameTimes, sizeof(gRenderFrameTimes));
+    // Like profiler_audio_started(), count everything outside the updates as PROFILER_TIME_SUB_AUDIO_UPDATE.
+    sSectionStarts[SECTION(UPDATE)] = host_cycles();
+}
+
+void render_frame_times_finish(void) {
+    u64 time = host_cycles();
+    gRenderFrameTimes.sections[SECTION(UPDATE)] += time - sSectionStarts[SECTION(UPDATE)];
+}
+
+void audio_render_profiler_switch(s32 complete1, s32 complete2, s32 begin, const char *func) {
+    u64 time = host_cycles();
+    struct RenderFrameTimes *times = &gRenderFrameTimes;
+
+    times->sections[complete1] += time - sSectionStarts[complete1];
+    if (complete2 >= 0) {
+        times->sections[complete2] += time - sSectionStarts[complete2];
+    }
+    sSectionStarts[begin] = time;
+
+    // Each audio update in synthesis_execute starts with its sequences and ends by switching
+    // back to PROFILER_TIME_SUB_AUDIO_UPDATE.
+    if (begin == SECTION(SEQUENCES)) {
+        sUpdateStart = time;
+    } else if (begin == SECTION(UPDATE)) {
+        u64 elapsed = time - sUpdateStart;
+        times->updateTotal += elapsed;
+        times->updateMax = MAX(times->updateMax, elapsed);
+        times->numUpdates++;
+    }
+
+    // synthesis_process_notes switches sections itself, but only synthesis_do_one_audio_update
+    // switches in and out of them around the whole call.
+    if (strcmp(func, "synthesis_do_one_audio_update") == 0) {
+        if (begin == SECTION(SYNTHESIS_PROCESSING)) {
+            sProcessNotesStart = time;
+        } else if (complete1 == SECTION(SYNTHESIS_PROCESSING)) {
+            u64 elapsed = time - sProcessNotesStart;
+            times->processNotesTotal += elapsed;
+            times->processNotesMax = MAX(times->processNotesMax, elapsed);
+            times->numProcessNotes++;
+        }
+    }
+}
+
+void audio_render_profiler_start_shared(s32 first, s32 new) {
+    sSectionStarts[new] = sSectionStarts[first];
+}
@@ -0,0 +1,182 @@
+/**
+ * BETTER_REVERB benchmark.
+ *
+ * With BETTER_REVERB the reverb filters run on the CPU: prepare_reverb_ring_buffer feeds the
+ * wet signal that the RSP mixed two frames earlier through the delay lines, once per audio
+ * update. This times that call for each preset in gBetterReverbSettings, on a noise input
+ * standing in for the RSP's output, and reports a checksum of the ring buffers afterwards so
+ * that two builds of the reverb code can be checked to produce the same samples.
+ *
+ * Like audio_render, the times are host cycles, for comparing builds on the same machine.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <ultra64.h>
+#include "audio/data.h"
+#include "audio/heap.h"
+#include "audio/internal.h"
+#include "audio/load.h"
+#include "audio/synthesis.h"
+
+#include "audio_render.h"
+
+#define DEFAULT_FRAMES      600
+#define UPDATES_PER_FRAME   4
+// samplesPerFrameTarget at 32kHz, split between the updates like synthesis_execute does.
+#define FRAME_SAMPLES       544
+// Frames run before timing starts, for the delay lines to fill up.
+#define WARMUP_FRAMES       60
+
+// The reverb only needs the sound data symbols to link; nothing is loaded from them.
+u8 gSoundDataADSR[1];
+u8 gSoundDataRaw[1];
+u8 gMusicData[1];
+u8 gBankSetsData[1];
+
+void prepare_reverb_ring_buffer(s32 chunkLen, u32 updateIndex);
+
+static ALIGNED16 u8 sBuffersPoolMem[0x40000];
+static ALIGNED16 u8 sBetterReverbPoolMem[BETTER_REVERB_SIZE];
+
+struct ReverbStat {
+    u64 total;
+    u64 max;
+    u64 count;
+};
+
+static u32 sNoiseState = 1;
+
+static s16 next_noise_sample(void) {
+    sNoiseState = sNoiseState * 1664525 + 1013904223;
+    // Keep the input well inside s16, like a mix of a few notes' wet signal.
+    return (s16) (sNoiseState >> 16) / 4;
+}
+
+/**
+ * Stand in for the RSP: write new wet samples to where the next call to
+ * prepare_reverb_ring_buffer reads them from.
+ */
+static void fill_reverb_input(u32 updateIndex) {
+    struct ReverbRingBufferItem *item = &gSynthesisReverb.items[gSynthesisReverb.curFrame][updateIndex];
+    s32 i;
+
+    if (gReverbDownsampleRate != 1) {
+        for (i = 0; i < (s32) (DEFAULT_LEN_1CH / sizeof(s16)); i++) {
+            item->toDownsampleLeft[i] = next_noise_sample();
+            item->toDownsampleRight[i] = next_noise_sample();
+        }
+        return;
+    }
+
+    for (i = 0; i < item->lengthA / 2; i++) {
+        gSynthesisReverb.ringBuffer.left[item->startPos + i] = next_noise_sample();
+        gSynthesisReverb.ringBuffer.right[item->startPos + i] = next_noise_sample();
+    }
+    for (i = 0; i < item->lengthB / 2; i++) {
+        gSynthesisReverb.ringBuffer.left[i] = next_noise_sample();
+        gSynthesisReverb.ringBuffer.right[i] = next_noise_sample();
+    }
+}
+
+static u32 checksum_ring_buffer(void) {
+    u32 hash = 2166136261U;
+
+    for (s32 i = 0; i < gSynthesisReverb.bufSizePerChannel; i++) {
+        hash = (hash ^ (u16) gSynthesisReverb.ringBuffer.left[i]) * 16777619U;
+        hash = (hash ^ (u16) gSynthesisReverb.ringBuffer.right[i]) * 16777619U;
+    }
+    return hash;
+}
+
+static void run_preset(u8 preset, u32 numFrames) {
+    struct ReverbStat stat = { 0 };
+
+    gBetterReverbPresetValue = preset;
+    init_reverb_us(0);
+    sAudioIsInitialized = TRUE;
+    update_better_reverb_parameters();
+    // Nothing is written to the ring buffer for the first two frames, since the RSP hasn't
+    // produced anything yet; there's no RSP here, so start right away.
+    gSynthesisReverb.framesLeftToIgnore = 0;
+    sNoiseState = 1;
+
+    for (u32 frame = 0; frame < WARMUP_FRAMES + numFrames; frame++) {
+        s32 samplesLeft = FRAME_SAMPLES;
+
+        for (s32 i = UPDATES_PER_FRAME; i > 0; i--) {
+            // Split the frame like synthesis_execute: evenly, rounded to the nearest multiple of 8.
+            s32 chunkLen = samplesLeft;
+            if (i != 1) {
+                chunkLen = samplesLeft / i;
+                chunkLen = (chunkLen - (chunkLen & 7)) + (((chunkLen & 7) >= 4) ? 8 : 0);
+            }
+            u32 updateIndex = UPDATES_PER_FRAME - i;
+
+            fill_reverb_input(updateIndex);
+            u64 start = host_cycles();
+            prepare_reverb_ring_buffer(chunkLen, updateIndex);
+            u64 elapsed = host_cycles() - start;
+
+            if (frame >= WARMUP_FRAMES) {
+                stat.total += elapsed;
+                stat.max = MAX(stat.max, elapsed);
+                stat.count++;
+            }
+            samplesLeft -= chunkLen;
+        }
+        gSynthesisReverb.curFrame ^= 1;
+    }
+
+    const char *kind = "vanilla";
+    s32 numFilters = 0;
+    if (toggleBetterReverb) {
+        kind = betterReverbLightweight ? "light" : "full";
+        numFilters = betterReverbLightweight ? BETTER_REVERB_FILTER_COUNT_LIGHT : reverbFilterCount;
+    }
+    printf("  %6u  %-8s %10d %7d %4d %10.0f %10llu  %08X\n", preset, kind, gReverbDownsampleRate, numFilters,
+           monoReverb, (stat.count != 0) ? ((f64) stat.total / stat.count) : 0.0,
+           (unsigned long long) stat.max, checksum_ring_buffer());
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [options]\n"
+           "\n"
+           "Times prepare_reverb_ring_buffer for each BETTER_REVERB preset.\n"
+           "\n"
+           "Options:\n"
+           "  -n <frames>  audio frames to time per preset (default %d)\n"
+           "  -p <preset>  only run this preset\n",
+           prog, DEFAULT_FRAMES);
+}
+
+int main(int argc, char **argv) {
+    u32 numFrames = DEFAULT_FRAMES;
+    s32 onlyPreset = -1;
+    s32 opt;
+
+    while ((opt = getopt(argc, argv, "n:p:h")) != -1) {
+        switch (opt) {
+            case 'n': numFrames = strtoul(optarg, NULL, 0); break;
+            case 'p': onlyPreset = strtol(optarg, NULL, 0); break;
+            default:
+                print_usage(argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    gAudioUpdatesPerFrame = UPDATES_PER_FRAME;
+    sound_alloc_pool_init(&gNotesAndBuffersPool, sBuffersPoolMem, sizeof(sBuffersPoolMem));
+    sound_alloc_pool_init(&gBetterReverbPool, sBetterReverbPoolMem, sizeof(sBetterReverbPoolMem));
+
+    printf("Host cycles per audio update (%d samples per frame in %d updates, %u frames):\n",
+           FRAME_SAMPLES, UPDATES_PER_FRAME, numFrames);
+    printf("  preset  kind     downsample filters mono        avg        max  checksum\n");
+    for (s32 preset = 0; preset < gBetterReverbPresetCount; preset++) {
+        if (onlyPreset < 0 || preset == onlyPreset) {
+            run_preset(preset, numFrames);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,380 @@
+/**
+ * A C implementation of the commands of the US audio microcode (rsp/audio.s), which the
+ * audio code's command lists are run through on the host.
+ *
+ * The audio code addresses DMEM relative to dmemBase, so DMEM here only holds that part,
+ * with some room in front for the samples the resampler puts before its input. DRAM addresses
+ * are plain host pointers, which is why the renderer keeps all audio memory in the low 4GB.
+ *
+ * Loads and stores go through memcpy, so data keeps the host's byte order: samples, codebooks
+ * and saved states are all native s16, as assemble_sound.py writes them with --endian native.
+ * The envelope mixer keeps its saved state in its own layout, since only it reads it back.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include <ultra64.h>
+#include "macros.h"
+
+#include "audio_render.h"
+
+#define DMEM_SIZE   0x1000
+#define DMEM_MARGIN 0x20
+
+struct RspAudioState {
+    u16 in;
+    u16 out;
+    u16 count;
+    u16 auxDryRight;
+    u16 auxWetLeft;
+    u16 auxWetRight;
+    s16 volLeft;
+    s16 volRight;
+    s16 targetLeft;
+    s16 targetRight;
+    s32 rateLeft;
+    s32 rateRight;
+    s16 dryGain;
+    s16 wetGain;
+    u8 *loopState;
+    s16 adpcmTable[8 * 16];
+};
+
+// Commands that run past the end of DMEM are reported, and land in the extra space after it.
+static u8 sDmemBuffer[DMEM_MARGIN + DMEM_SIZE + DMEM_SIZE] __attribute__((aligned(16)));
+static struct RspAudioState sState;
+
+// The resampler's 64 sets of 4 filter coefficients, copied from the microcode's data.
+static const s16 sResampleTable[64 * 4] = {
+#include "resample_table.inc.c"
+};
+
+static ALWAYS_INLINE u8 *dmem(u32 addr) {
+    return &sDmemBuffer[DMEM_MARGIN + (addr & (DMEM_SIZE - 1))];
+}
+
+static ALWAYS_INLINE s16 *dmem_s16(u32 addr) {
+    return (s16 *) dmem(addr);
+}
+
+static ALWAYS_INLINE void *dram(u32 addr) {
+    return (void *) (uintptr_t) (addr & ~7);
+}
+
+static ALWAYS_INLINE s16 clamp16(s32 value) {
+    if (value < -0x8000) {
+        return -0x8000;
+    }
+    if (value > 0x7fff) {
+        return 0x7fff;
+    }
+    return value;
+}
+
+static void dmem_check(u32 addr, u32 size, const char *cmd) {
+    if ((addr & (DMEM_SIZE - 1)) + size > DMEM_SIZE) {
+        fprintf(stderr, "rsp_audio: %s reaches past DMEM (0x%x + 0x%x)\n", cmd, addr, size);
+    }
+}
+
+static void cmd_clearbuff(u32 w0, u32 w1) {
+    u32 count = ALIGN16(w1 & 0xffff);
+    dmem_check(w0 & 0xffff, count, "CLEARBUFF");
+    bzero(dmem(w0), count);
+}
+
+static void cmd_loadbuff(u32 w1) {
+    u32 count = ALIGN8(sState.count);
+    dmem_check(sState.in, count, "LOADBUFF");
+    memcpy(dmem(sState.in), dram(w1), count);
+}
+
+static void cmd_savebuff(u32 w1) {
+    u32 count = ALIGN8(sState.count);
+    dmem_check(sState.out, count, "SAVEBUFF");
+    memcpy(dram(w1), dmem(sState.out), count);
+}
+
+static void cmd_loadadpcm(u32 w0, u32 w1) {
+    u32 count = MIN(ALIGN8(w0 & 0xffff), sizeof(sState.adpcmTable));
+    memcpy(sState.adpcmTable, dram(w1), count);
+}
+
+static void cmd_setbuff(u32 w0, u32 w1) {
+    if ((w0 >> 16) & A_AUX) {
+        sState.auxDryRight = w0;
+        sState.auxWetLeft = w1 >> 16;
+        sState.auxWetRight = w1;
+    } else {
+        sState.in = w0;
+        sState.out = w1 >> 16;
+        sState.count = w1;
+    }
+}
+
+static void cmd_setvol(u32 w0, u32 w1) {
+    u32 flags = (w0 >> 16);
+
+    if (flags & A_AUX) {
+        sState.dryGain = w0;
+        sState.wetGain = w1;
+    } else if (flags & A_VOL) {
+        if (flags & A_LEFT) {
+            sState.volLeft = w0;
+        } else {
+            sState.volRight = w0;
+        }
+    } else if (flags & A_LEFT) {
+        sState.targetLeft = w0;
+        sState.rateLeft = w1;
+    } else {
+        sState.targetRight = w0;
+        sState.rateRight = w1;
+    }
+}
+
+static void cmd_interleave(u32 w1) {
+    u32 count = ALIGN16(sState.count) / 2;
+    s16 *left = dmem_s16(w1 >> 16);
+    s16 *right = dmem_s16(w1 & 0xffff);
+    s16 *out = dmem_s16(sState.out);
+
+    dmem_check(sState.out, count * 4, "INTERLEAVE");
+    for (u32 i = 0; i < count; i++) {
+        *out++ = left[i];
+        *out++ = right[i];
+    }
+}
+
+static void cmd_dmemmove(u32 w0, u32 w1) {
+    s32 count = (w1 & 0xffff);
+    u8 *in = dmem(w0);
+    u8 *out = dmem(w1 >> 16);
+
+    // The microcode copies forwards in 16 byte steps, which the audio code relies on when
+    // moving samples down within a buffer.
+    dmem_check(w1 >> 16, ALIGN16(count), "DMEMMOVE");
+    for (; count > 0; count -= 16, in += 16, out += 16) {
+        memmove(out, in, 16);
+    }
+}
+
+static void cmd_setloop(u32 w1) {
+    sState.loopState = dram(w1);
+}
+
+static void adpcm_residuals(s16 *dst, const s16 *src, const s16 *book, s16 l1, s16 l2) {
+    const s16 *book2 = (book + 8);
+
+    for (s32 i = 0; i < 8; i++) {
+        s32 acc = ((s32) src[i] << 11) + (book[i] * l1) + (book2[i] * l2);
+        for (s32 j = 0; j < i; j++) {
+            acc += book2[j] * src[i - 1 - j];
+        }
+        dst[i] = clamp16(acc >> 11);
+    }
+}
+
+static void cmd_adpcm(u32 w0, u32 w1) {
+    u32 flags = (w0 >> 16) & 0xff;
+    s32 count = ALIGN32(sState.count);
+    u8 *in = dmem(sState.in);
+    s16 *out = dmem_s16(sState.out);
+    s16 *stateAddr = dram(w1);
+    s16 lastFrame[16];
+
+    if (flags & A_INIT) {
+        bzero(lastFrame, sizeof(lastFrame));
+    } else {
+        memcpy(lastFrame, (flags & A_LOOP) ? (s16 *) sState.loopState : stateAddr, sizeof(lastFrame));
+    }
+
+    dmem_check(sState.out, count + sizeof(lastFrame), "ADPCM");
+    memcpy(out, lastFrame, sizeof(lastFrame));
+    out += 16;
+
+    for (; count > 0; count -= 32) {
+        s16 frame[16];
+        u8 code = *in++;
+        s32 rshift = ((code >> 4) < 12) ? (12 - (code >> 4)) : 0;
+        const s16 *book = &sState.adpcmTable[(code & 0xf) * 16];
+
+        for (s32 i = 0; i < 8; i++) {
+            u8 byte = *in++;
+            frame[i * 2 + 0] = (s16) ((byte & 0xf0) << 8) >> rshift;
+            frame[i * 2 + 1] = (s16) ((byte & 0x0f) << 12) >> rshift;
+        }
+
+        adpcm_residuals(&lastFrame[0], &frame[0], book, lastFrame[14], lastFrame[15]);
+        adpcm_residuals(&lastFrame[8], &frame[8], book, lastFrame[6], lastFrame[7]);
+        memcpy(out, lastFrame, sizeof(lastFrame));
+        out += 16;
+    }
+
+    memcpy(stateAddr, lastFrame, sizeof(lastFrame));
+}
+
+static void cmd_resample(u32 w0, u32 w1) {
+    u32 flags = (w0 >> 16) & 0xff;
+    u32 pitch = (w0 & 0xffff) << 1;
+    s32 count = ALIGN16(sState.count) / 2;
+    s16 *in = dmem_s16(sState.in) - 4;
+    s16 *out = dmem_s16(sState.out);
+    s16 *state = dram(w1);
+    u32 acc;
+
+    if (flags & 2) {
+        static s32 sWarned = FALSE;
+        if (!sWarned) {
+            fprintf(stderr, "rsp_audio: RESAMPLE flag 2 is not emulated\n");
+            sWarned = TRUE;
+        }
+    }
+
+    if (flags & A_INIT) {
+        bzero(in, 4 * sizeof(s16));
+        acc = 0;
+    } else {
+        memcpy(in, state, 4 * sizeof(s16));
+        acc = (u16) state[4];
+    }
+
+    dmem_check(sState.out, count * 2, "RESAMPLE");
+    for (; count > 0; count--) {
+        const s16 *lut = &sResampleTable[(acc >> 10) * 4];
+        s32 sum = (in[0] * lut[0]) + (in[1] * lut[1]) + (in[2] * lut[2]) + (in[3] * lut[3]);
+        *out++ = clamp16((sum + 0x4000) >> 15);
+
+        acc += pitch;
+        in += (acc >> 16);
+        acc &= 0xffff;
+    }
+
+    memcpy(state, in, 4 * sizeof(s16));
+    state[4] = acc;
+}
+
+/**
+ * The envelope mixer's saved state, which has to fit in an ENVMIX_STATE.
+ */
+struct EnvMixerState {
+    s32 wetGain;
+    s32 dryGain;
+    s32 target[2];
+    s32 rate[2];
+    s32 expSeq[2];
+    s32 value[2];
+};
+
+static ALWAYS_INLINE s16 envmixer_ramp_step(s32 *value, s32 *step, s32 target) {
+    *value += *step;
+    if ((*step <= 0) ? (*value <= target) : (*value >= target)) {
+        *value = target;
+        *step = 0;
+    }
+    return (*value >> 16);
+}
+
+static void cmd_envmixer(u32 w0, u32 w1) {
+    u32 flags = (w0 >> 16) & 0xff;
+    s32 count = ALIGN16(sState.count) / 2;
+    s16 *in = dmem_s16(sState.in);
+    s16 *dryLeft = dmem_s16(sState.out);
+    s16 *dryRight = dmem_s16(sState.auxDryRight);
+    s16 *wetLeft = dmem_s16(sState.auxWetLeft);
+    s16 *wetRight = dmem_s16(sState.auxWetRight);
+    struct EnvMixerState *saved = dram(w1);
+    struct EnvMixerState env;
+    s32 step[2];
+
+    STATIC_ASSERT(sizeof(struct EnvMixerState) <= sizeof(ENVMIX_STATE), "Envelope mixer state is too large");
+
+    if (flags & A_INIT) {
+        env.wetGain = sState.wetGain;
+        env.dryGain = sState.dryGain;
+        env.value[0] = (sState.volLeft << 16);
+        env.value[1] = (sState.volRight << 16);
+        env.target[0] = (sState.targetLeft << 16);
+        env.target[1] = (sState.targetRight << 16);
+        env.rate[0] = sState.rateLeft;
+        env.rate[1] = sState.rateRight;
+        env.expSeq[0] = (sState.volLeft * sState.rateLeft);
+        env.expSeq[1] = (sState.volRight * sState.rateRight);
+    } else {
+        memcpy(&env, saved, sizeof(env));
+    }
+
+    step[0] = env.target[0] - env.value[0];
+    step[1] = env.target[1] - env.value[1];
+
+    dmem_check(sState.out, count * 2, "ENVMIXER");
+    for (s32 i = 0; i < count; i += 8) {
+        for (s32 ch = 0; ch < 2; ch++) {
+            if (step[ch] != 0) {
+                env.expSeq[ch] = ((s64) env.expSeq[ch] * env.rate[ch]) >> 16;
+                step[ch] = (env.expSeq[ch] - env.value[ch]) >> 3;
+            }
+        }
+
+        for (s32 j = i; j < i + 8; j++) {
+            s16 volLeft = envmixer_ramp_step(&env.value[0], &step[0], env.target[0]);
+            s16 volRight = envmixer_ramp_step(&env.value[1], &step[1], env.target[1]);
+            s16 sample = in[j];
+
+            s16 gain = clamp16((volLeft * env.dryGain + 0x4000) >> 15);
+            dryLeft[j] = clamp16(dryLeft[j] + ((sample * gain) >> 15));
+            gain = clamp16((volRight * env.dryGain + 0x4000) >> 15);
+            dryRight[j] = clamp16(dryRight[j] + ((sample * gain) >> 15));
+
+            if (flags & A_AUX) {
+                gain = clamp16((volLeft * env.wetGain + 0x4000) >> 15);
+                wetLeft[j] = clamp16(wetLeft[j] + ((sample * gain) >> 15));
+                gain = clamp16((volRight * env.wetGain + 0x4000) >> 15);
+                wetRight[j] = clamp16(wetRight[j] + ((sample * gain) >> 15));
+            }
+        }
+    }
+
+    memcpy(saved, &env, sizeof(env));
+}
+
+static void cmd_mixer(u32 w0, u32 w1) {
+    s32 count = ALIGN32(sState.count) / 2;
+    s16 gain = w0;
+    s16 *in = dmem_s16(w1 >> 16);
+    s16 *out = dmem_s16(w1 & 0xffff);
+
+    dmem_check(w1 & 0xffff, count * 2, "MIXER");
+    for (s32 i = 0; i < count; i++) {
+        out[i] = clamp16(((out[i] * 0x7fff) + (in[i] * gain) + 0x4000) >> 15);
+    }
+}
+
+void rsp_audio_run_task(u64 *cmdList, u32 numCmds) {
+    for (u32 i = 0; i < numCmds; i++) {
+        Acmd *cmd = (Acmd *) &cmdList[i];
+        u32 w0 = cmd->words.w0;
+        u32 w1 = cmd->words.w1;
+
+        switch (w0 >> 24) {
+            case A_SPNOOP:    break;
+            case A_ADPCM:     cmd_adpcm(w0, w1); break;
+            case A_CLEARBUFF: cmd_clearbuff(w0, w1); break;
+            case A_ENVMIXER:  cmd_envmixer(w0, w1); break;
+            case A_LOADBUFF:  cmd_loadbuff(w1); break;
+            case A_RESAMPLE:  cmd_resample(w0, w1); break;
+            case A_SAVEBUFF:  cmd_savebuff(w1); break;
+            case A_SEGMENT:   break; // Addresses are host pointers, so there are no segments.
+            case A_SETBUFF:   cmd_setbuff(w0, w1); break;
+            case A_SETVOL:    cmd_setvol(w0, w1); break;
+            case A_DMEMMOVE:  cmd_dmemmove(w0, w1); break;
+            case A_LOADADPCM: cmd_loadadpcm(w0, w1); break;
+            case A_MIXER:     cmd_mixer(w0, w1); break;
+            case A_INTERLEAVE: cmd_interleave(w1); break;
+            case A_SETLOOP:   cmd_setloop(w1); break;
+            default:
+                fprintf(stderr, "rsp_audio: unknown command 0x%02x\n", w0 >> 24);
+                break;
+        }
+    }
+}
@@ -0,0 +1,25 @@
+# The sound data from assemble_sound.py, like sound/sound_data.s but for the host's assembler.
+
+.section .data
+
+.balign 16
+.globl gSoundDataADSR
+gSoundDataADSR:
+.incbin "sound_data.ctl"
+
+.balign 16
+.globl gSoundDataRaw
+gSoundDataRaw:
+.incbin "sound_data.tbl"
+
+.balign 16
+.globl gMusicData
+gMusicData:
+.incbin "sequences.bin"
+
+.balign 16
+.globl gBankSetsData
+gBankSetsData:
+.incbin "bank_sets"
+
+.section .note.GNU-stack, "", @progbits
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""
+Write the sample of the audio_render test: a looped 500 Hz tone at 32 kHz, as an AIFF for
+aiff_extract_codebook and vadpcm_enc.
+
+    python3 make_tone.py 00_tone.aiff
+
+The wave is built with integer arithmetic only, so that the file, and the sound rendered from it,
+are the same on every machine.
+"""
+import struct
+import sys
+
+SAMPLE_RATE = 32000
+PERIOD = 64            # 500 Hz
+NUM_FRAMES = 4096
+LOOP_START = 1024      # Both loop points are on 16 sample ADPCM frames, and the loop is whole periods.
+AMPLITUDE = 12000
+
+
+def sample_at(i):
+    # A triangle with its third harmonic, so the resampler and ADPCM have something to round.
+    phase = i % PERIOD
+    tri = (4 * phase - PERIOD) if phase < PERIOD // 2 else (3 * PERIOD - 4 * phase)
+    phase3 = (3 * i) % PERIOD
+    tri3 = (4 * phase3 - PERIOD) if phase3 < PERIOD // 2 else (3 * PERIOD - 4 * phase3)
+    value = (tri * 3 + tri3) * AMPLITUDE // (4 * PERIOD)
+    # Fade in over the part before the loop.
+    if i < LOOP_START:
+        value = value * i // LOOP_START
+    return value
+
+
+def f80(value):
+    """An integer as an IEEE 754 80-bit extended float, the way AIFF stores the sample rate."""
+    exponent = value.bit_length() - 1
+    return struct.pack(">HQ", 0x3FFF + exponent, value << (63 - exponent))
+
+
+def chunk(name, data):
+    return name + struct.pack(">I", len(data)) + data + (b"\0" if len(data) % 2 else b"")
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("Usage: %s <output.aiff>" % sys.argv[0])
+
+    comm = struct.pack(">hIh", 1, NUM_FRAMES, 16) + f80(SAMPLE_RATE)
+    # Marker 1 starts the loop and marker 2 ends it; the names are empty pascal strings, padded to an even length.
+    mark = struct.pack(">h", 2) + struct.pack(">hIbx", 1, LOOP_START, 0) + struct.pack(">hIbx", 2, NUM_FRAMES, 0)
+    # Base note 60, full key and velocity range, no gain; the sustain loop runs forward between the markers.
+    inst = struct.pack(">bbbbbbh", 60, 0, 0, 127, 0, 127, 0) + struct.pack(">hhh", 1, 1, 2) + struct.pack(">hhh", 0, 0, 0)
+    ssnd = struct.pack(">II", 0, 0) + b"".join(struct.pack(">h", sample_at(i)) for i in range(NUM_FRAMES))
+
+    body = b"AIFF" + chunk(b"COMM", comm) + chunk(b"MARK", mark) + chunk(b"INST", inst) + chunk(b"SSND", ssnd)
+    with open(sys.argv[1], "wb") as f:
+        f.write(b"FORM" + struct.pack(">I", len(body)) + body)
+
+
+if __name__ == "__main__":
+    main()
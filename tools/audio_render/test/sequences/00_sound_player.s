@@ -0,0 +1,12 @@
+// Stands in for the sound effects sequence, which sound_init starts; the test plays no sound effects.
+#include "seq_macros.inc"
+
+.section .rodata
+.align 0
+
+sequence_start:
+seq_setvol 127
+seq_settempo 120
+.seq_loop:
+seq_delay 20000
+seq_jump .seq_loop
@@ -0,0 +1,58 @@
+// The sequence rendered by the audio_render test: a melody and a chord on the test tone, on two
+// channels with different instruments, pans and reverb, for about two seconds.
+#include "seq_macros.inc"
+
+.section .rodata
+.align 0
+
+sequence_start:
+seq_setmutebhv 0x60
+seq_setmutescale 0
+seq_setvol 127
+seq_settempo 120
+seq_initchannels 0x03
+seq_startchannel 0, .channel0
+seq_startchannel 1, .channel1
+seq_delay 192
+seq_end
+
+.channel0:
+chan_largenoteson
+chan_setinstr 0
+chan_setvol 100
+chan_setpan 32
+chan_setreverb 40
+chan_setlayer 0, .layer_melody
+chan_delay 192
+chan_end
+
+.channel1:
+chan_largenoteson
+chan_setinstr 1
+chan_setvol 80
+chan_setpan 96
+chan_setvibratoextent 8
+chan_setvibratorate 40
+chan_setlayer 0, .layer_chord_root
+chan_setlayer 1, .layer_chord_third
+chan_delay 192
+chan_end
+
+.layer_melody:
+layer_note1 39, 24, 100
+layer_note1 41, 24, 100
+layer_note1 43, 24, 100
+layer_note1 44, 24, 100
+layer_note1 46, 48, 110
+layer_delay 24
+layer_end
+
+.layer_chord_root:
+layer_delay 48
+layer_note1 27, 96, 90
+layer_end
+
+.layer_chord_third:
+layer_delay 48
+layer_note1 31, 96, 90
+layer_end
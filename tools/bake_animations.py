@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+Convert object animations to the baked format, which can be drawn without decoding them.
+
+    python3 tools/bake_animations.py actors/goomba/anims/*.inc.c
+
+Animations normally store each value (a translation or rotation axis of one part) as its own list of frames, and
+each object looks up every value in the index table every time it's drawn. Baked animations store every frame in
+full instead, with all values of a frame next to each other in the order they are drawn, so the renderer just
+points at the current frame. Values that don't change, which the normal format stores once, are repeated for
+every frame, so baked animations take more space. The size of each animation before and after is printed.
+
+Files are converted in place. The index table is removed, the values are replaced, and the animation is given
+ANIM_FLAG_BAKED with its number of frames in the length field. Mario's animations can't be baked, since they
+are also read when Mario moves.
+"""
+import re
+import sys
+
+ARRAY_DEF = re.compile(r"static\s+const\s+(s16|u16)\s+(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\};\n*", re.S)
+ANIM_DEF = re.compile(r"(static\s+const\s+struct\s+Animation\s+(\w+)\s*=\s*\{)(.*?)(\};)", re.S)
+
+ANIM_FIELDS = 9
+(FIELD_FLAGS, FIELD_Y_DIVISOR, FIELD_START_FRAME, FIELD_LOOP_START, FIELD_LOOP_END, FIELD_NUM_PARTS,
+ FIELD_VALUES, FIELD_INDEX, FIELD_LENGTH) = range(ANIM_FIELDS)
+
+
+def parse_array(text):
+    values = []
+    for entry in re.sub(r"//.*", "", text).split(","):
+        if entry.strip():
+            value = int(entry.strip(), 0) & 0xFFFF
+            values.append(value - 0x10000 if value >= 0x8000 else value)
+    return values
+
+
+def bake(values, index):
+    """Returns the frame count and the frame-major values of an animation."""
+    channels = [(index[i], index[i + 1]) for i in range(0, len(index), 2)]
+    numFrames = max(length for length, offset in channels)
+    baked = []
+    for frame in range(numFrames):
+        for length, offset in channels:
+            baked.append(values[offset + min(frame, length - 1)])
+    return numFrames, baked
+
+
+def format_array(name, values):
+    lines = ["static const s16 %s[] = {" % name]
+    for i in range(0, len(values), 8):
+        lines.append("    " + " ".join("0x%04X," % (v & 0xFFFF) for v in values[i:i + 8]))
+    lines.append("};\n\n")
+    return "\n".join(lines)
+
+
+def bake_file(path):
+    with open(path) as f:
+        text = f.read()
+
+    arrays = {m.group(2): parse_array(m.group(3)) for m in ARRAY_DEF.finditer(text)}
+    oldSize = sum(2 * len(v) for v in arrays.values())
+    converted = 0
+
+    for m in reversed(list(ANIM_DEF.finditer(text))):
+        name = m.group(2)
+        fields = [f.strip() for f in m.group(3).split(",") if f.strip()]
+        if len(fields) != ANIM_FIELDS:
+            print("%s: %s: expected %d fields" % (path, name, ANIM_FIELDS), file=sys.stderr)
+            continue
+        if "ANIM_FLAG_BAKED" in fields[FIELD_FLAGS]:
+            continue
+        valuesName, indexName = fields[FIELD_VALUES], fields[FIELD_INDEX]
+        if valuesName not in arrays or indexName not in arrays:
+            print("%s: %s: values or index not in this file" % (path, name), file=sys.stderr)
+            continue
+
+        index = [v & 0xFFFF for v in arrays[indexName]]
+        numFrames, baked = bake(arrays[valuesName], index)
+        numParts = len(index) // 6 - 1
+        bakedName = name + "_baked"
+
+        fields[FIELD_FLAGS] = ("ANIM_FLAG_BAKED" if fields[FIELD_FLAGS] in ("0", "0x00")
+                               else "%s | ANIM_FLAG_BAKED" % fields[FIELD_FLAGS])
+        fields[FIELD_NUM_PARTS] = str(numParts)
+        fields[FIELD_VALUES] = bakedName
+        fields[FIELD_INDEX] = "NULL"
+        fields[FIELD_LENGTH] = str(numFrames)
+        struct = m.group(1) + "\n" + "".join("    %s,\n" % f for f in fields) + m.group(4)
+        text = text[:m.start()] + format_array(bakedName, baked) + struct + text[m.end():]
+        converted += 1
+
+    # Remove the arrays nothing uses anymore.
+    for m in reversed(list(ARRAY_DEF.finditer(text))):
+        if len(re.findall(r"\b%s\b" % m.group(2), text)) == 1:
+            start = m.start()
+            # Along with the comment before them, if any.
+            comment = re.search(r"// [^\n]*\n$", text[:start])
+            if comment is not None:
+                start = comment.start()
+            text = text[:start] + text[m.end():]
+
+    if converted != 0:
+        newSize = sum(2 * len(parse_array(m.group(3))) for m in ARRAY_DEF.finditer(text))
+        with open(path, "w") as f:
+            f.write(text)
+        print("%s: %d bytes -> %d bytes" % (path, oldSize, newSize))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("usage: bake_animations.py <anim .inc.c files>", file=sys.stderr)
+        sys.exit(1)
+    for path in sys.argv[1:]:
+        bake_file(path)
+
+
+if __name__ == "__main__":
+    main()
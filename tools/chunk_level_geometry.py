@@ -0,0 +1,476 @@
+#!/usr/bin/env python3
+"""
+Split a level display list into spatial chunks that can each be culled with GEO_CULLING_BOX.
+
+    python3 tools/chunk_level_geometry.py levels/bob/areas/1/1/model.inc.c bob_dl_Terrain_mesh_layer_1 \\
+        --cell-size 2000 --layer LAYER_OPAQUE --out-dl chunks.inc.c --out-geo chunks_geo.inc.c
+
+The triangles of the display list (and of the lists it calls from the same file) are sorted into a grid by their
+centres. Each grid cell becomes a display list of its own with its own vertices. Before each of its triangle batches,
+a chunk sets up the render state the original has at that point, leaving out commands whose effect was replaced
+before it is used, such as the texture loads and combiners of materials the chunk doesn't draw. The chunks are then grouped into a tree of boxes,
+and the geo output draws them all:
+
+    GEO_CULLING_BOX(...)
+    GEO_OPEN_NODE()
+        GEO_CULLING_BOX(...)
+        GEO_OPEN_NODE()
+            GEO_DISPLAY_LIST(LAYER_OPAQUE, <dl>_chunk_0)
+        ...
+
+Include the display list output next to the original model, and replace the original GEO_DISPLAY_LIST in the
+area's geo layout with the geo output. Boxes are in the display list's own coordinates, so it has to be under the
+same transform as before.
+"""
+import argparse
+import re
+import sys
+
+VTX_ENTRY = re.compile(r"\{\s*\{\s*\{([^}]*)\}\s*,([^,{}]*),\s*\{([^}]*)\}\s*,\s*\{([^}]*)\}\s*\}\s*\}")
+ARRAY_DEF = re.compile(r"(Vtx|Gfx)\s+(\w+)\s*\[[^\]]*\]\s*(?:__attribute__\s*\(\(.*?\)\)\s*)?=\s*\{", re.S)
+VTX_REF = re.compile(r"^\s*&?\s*(\w+)\s*(?:\[\s*(\w+)\s*\]|\+\s*(\w+))?\s*$")
+
+S16_MIN = -0x8000
+S16_MAX = 0x7FFF
+
+
+def parse_int(text):
+    return int(text.strip(), 0)
+
+
+def split_args(text):
+    """Split the arguments of a macro call at the top level commas."""
+    args = []
+    depth = 0
+    start = 0
+    for i, c in enumerate(text):
+        if c in "([{":
+            depth += 1
+        elif c in ")]}":
+            depth -= 1
+        elif c == "," and depth == 0:
+            args.append(text[start:i].strip())
+            start = i + 1
+    if text[start:].strip():
+        args.append(text[start:].strip())
+    return args
+
+
+def array_body(source, start):
+    """Return the text between the braces of an array definition whose opening brace is at start - 1."""
+    depth = 1
+    i = start
+    while depth > 0:
+        if source[i] == "{":
+            depth += 1
+        elif source[i] == "}":
+            depth -= 1
+        i += 1
+    return source[start:i - 1]
+
+
+def parse_commands(body):
+    """Split a Gfx array into (macro, args) tuples."""
+    body = re.sub(r"/\*.*?\*/|//[^\n]*", "", body, flags=re.S)
+    commands = []
+    for entry in split_args(body):
+        match = re.match(r"(\w+)\s*\((.*)\)\s*$", entry, re.S)
+        if match is None:
+            sys.exit("Can't parse display list command: %s" % entry)
+        commands.append((match.group(1), split_args(match.group(2))))
+    return commands
+
+
+def parse_source(source):
+    vtxArrays = {}
+    gfxArrays = {}
+    for match in ARRAY_DEF.finditer(source):
+        body = array_body(source, match.end())
+        if match.group(1) == "Vtx":
+            vtxArrays[match.group(2)] = [
+                (tuple(parse_int(x) for x in m.group(1).split(",")), parse_int(m.group(2)),
+                 tuple(parse_int(x) for x in m.group(3).split(",")), tuple(parse_int(x) for x in m.group(4).split(",")))
+                for m in VTX_ENTRY.finditer(body)
+            ]
+        else:
+            gfxArrays[match.group(2)] = parse_commands(body)
+    return vtxArrays, gfxArrays
+
+
+# Commands that set one piece of state, replacing what the last command of the same kind set.
+SINGLE_STATE_COMMANDS = {
+    "gsDPSetCombineMode": "combine",
+    "gsDPSetCombineLERP": "combine",
+    "gsSPTexture": "texture",
+    "gsSPTextureL": "texture",
+    "gsSPFogPosition": "fog",
+    "gsSPFogFactor": "fog",
+}
+for macro in ("gsDPSetRenderMode", "gsDPSetCycleType", "gsDPSetPrimColor", "gsDPSetEnvColor", "gsDPSetFogColor",
+              "gsDPSetBlendColor", "gsDPSetFillColor", "gsDPSetPrimDepth", "gsDPSetDepthSource", "gsDPSetTextureFilter",
+              "gsDPSetTexturePersp", "gsDPSetTextureLOD", "gsDPSetTextureLUT", "gsDPSetTextureDetail",
+              "gsDPSetTextureConvert", "gsDPSetAlphaCompare", "gsDPSetColorDither", "gsDPSetAlphaDither",
+              "gsDPSetCombineKey", "gsDPSetConvert", "gsDPSetKeyR", "gsDPSetKeyGB", "gsDPPipelineMode",
+              "gsDPSetScissor", "gsSPClipRatio", "gsSPNumLights"):
+    SINGLE_STATE_COMMANDS[macro] = macro
+
+OTHER_MODE_STATE = ("gsDPSetRenderMode", "gsDPSetCycleType", "gsDPSetDepthSource", "gsDPSetTextureFilter",
+                    "gsDPSetTexturePersp", "gsDPSetTextureLOD", "gsDPSetTextureLUT", "gsDPSetTextureDetail",
+                    "gsDPSetTextureConvert", "gsDPSetAlphaCompare", "gsDPSetColorDither", "gsDPSetAlphaDither",
+                    "gsDPSetCombineKey", "gsDPPipelineMode")
+
+# Load macros that load a texture to TMEM address 0 and set up the render tile for it.
+TEXTURE_LOAD_MACROS = ("gsDPLoadTextureBlock", "gsDPLoadTextureBlock_4b", "gsDPLoadTextureBlockS",
+                       "gsDPLoadTextureBlock_4bS", "gsDPLoadTextureTile", "gsDPLoadTextureTile_4b")
+# Load macros that take the TMEM address and render tile as their second and third arguments.
+MULTI_LOAD_MACROS = ("gsDPLoadMultiBlock", "gsDPLoadMultiBlock_4b", "gsDPLoadMultiBlockS",
+                     "gsDPLoadMultiBlock_4bS", "gsDPLoadMultiTile", "gsDPLoadMultiTile_4b")
+# Commands that load TMEM through the tile given by their first argument.
+LOAD_COMMANDS = ("gsDPLoadBlock", "gsDPLoadTile", "gsDPLoadTLUTCmd")
+SYNC_COMMANDS = ("gsDPPipeSync", "gsDPLoadSync", "gsDPTileSync", "gsDPFullSync")
+
+TEXTURE_STATE = ("texture image", "tmem:", "tile:", "tile size:")
+
+TILE_NAMES = {"G_TX_RENDERTILE": 0, "G_TX_LOADTILE": 7}
+
+
+def parse_value(text):
+    """Parse a number if it is one, so that equal values written differently compare equal."""
+    try:
+        return parse_int(text)
+    except ValueError:
+        return text.strip()
+
+
+def parse_tile(text):
+    return TILE_NAMES.get(text.strip(), parse_value(text))
+
+
+def parse_flags(text):
+    return [f.strip() for f in text.split("|") if parse_value(f) != 0]
+
+
+def format_command(command):
+    return "%s(%s)" % (command[0], ", ".join(command[1]))
+
+
+class RenderState:
+    """
+    Render state commands that are waiting to be emitted. Each entry is a group of commands and the pieces of state
+    it sets; an entry is dropped once every piece of state it sets has been set again by a later one, so only the
+    commands that still matter when the next triangles are drawn are emitted, in their original order.
+    """
+
+    def __init__(self):
+        self.entries = []
+        self.tiles = {}
+        self.load = None
+        # The tile descriptors the emitted commands have set up so far.
+        self.emittedTiles = {}
+
+    def add_entry(self, commands, keys):
+        keys = set(keys)
+        for entry in self.entries:
+            entry[1].difference_update(keys)
+            if "geometry mode" in keys:
+                entry[1].difference_update([k for k in entry[1] if k.startswith("geometry mode:")])
+        self.entries = [entry for entry in self.entries if entry[1]]
+        self.entries.append((commands, keys))
+
+    def close_load(self, tmem):
+        """Finish a texture load started by gsDPSetTextureImage."""
+        commands, keys = self.load
+        self.load = None
+        if tmem is None:
+            self.add_entry(commands, keys)
+            return
+        loadTile = parse_tile(commands[-1][1][0])
+        # Vanilla lists set up the load tile once and reuse it, so bring along the one this load used.
+        if "tile:%s" % loadTile not in keys and loadTile in self.tiles:
+            commands.insert(1, self.tiles[loadTile])
+        self.add_entry(commands, keys | {"tmem:%s" % tmem})
+
+    def add(self, command):
+        macro, args = command
+
+        if self.load is not None:
+            if macro == "gsDPSetTile" or macro in SYNC_COMMANDS:
+                self.load[0].append(command)
+                if macro == "gsDPSetTile":
+                    self.tiles[parse_tile(args[4])] = command
+                    self.load[1].add("tile:%s" % parse_tile(args[4]))
+                return
+            if macro in LOAD_COMMANDS:
+                self.load[0].append(command)
+                tile = self.tiles.get(parse_tile(args[0]))
+                self.close_load(None if tile is None else parse_value(tile[1][3]))
+                return
+            self.close_load(None)
+
+        if macro in SYNC_COMMANDS:
+            # Syncs are emitted where they are needed in flush.
+            return
+        if macro == "gsDPSetTextureImage":
+            self.load = ([command], {"texture image"})
+        elif macro in SINGLE_STATE_COMMANDS:
+            self.add_entry([command], {SINGLE_STATE_COMMANDS[macro]})
+        elif macro == "gsDPSetOtherMode":
+            self.add_entry([command], OTHER_MODE_STATE)
+        elif macro == "gsDPSetTile":
+            self.tiles[parse_tile(args[4])] = command
+            self.add_entry([command], {"tile:%s" % parse_tile(args[4])})
+        elif macro == "gsDPSetTileSize":
+            self.add_entry([command], {"tile size:%s" % parse_tile(args[0])})
+        elif macro in TEXTURE_LOAD_MACROS:
+            self.add_entry([command], {"texture image", "tmem:0", "tile:7", "tile:0", "tile size:0"})
+        elif macro in MULTI_LOAD_MACROS:
+            tile = parse_tile(args[2])
+            self.add_entry([command], {"texture image", "tmem:%s" % parse_value(args[1]), "tile:7",
+                                       "tile:%s" % tile, "tile size:%s" % tile})
+        elif macro in ("gsSPSetGeometryMode", "gsSPClearGeometryMode"):
+            self.add_entry([command], {"geometry mode:%s" % f for f in parse_flags(args[0])})
+        elif macro == "gsSPGeometryMode":
+            self.add_entry([command], {"geometry mode:%s" % f for f in parse_flags(args[0]) + parse_flags(args[1])})
+        elif macro == "gsSPLoadGeometryMode":
+            self.add_entry([command], {"geometry mode"})
+        elif macro == "gsSPLightColor":
+            self.add_entry([command], {"light color:%s" % args[0].strip()})
+        else:
+            # Anything else, like a call to a material list, is kept unless it is repeated exactly.
+            self.add_entry([command], {format_command(command)})
+
+    def flush(self, end=False):
+        """
+        Return the commands to emit before the next triangles, and start over. At the end of the list, texture
+        loads and tiles are left out: what the original leaves in TMEM isn't used by anything drawn after it.
+        """
+        if self.load is not None:
+            self.close_load(None)
+        if end:
+            self.entries = [entry for entry in self.entries if not all(k.startswith(TEXTURE_STATE) for k in entry[1])]
+        commands = []
+        for command in (c for entry in self.entries for c in entry[0]):
+            macro, args = command
+            if macro == "gsDPSetTile":
+                # Loads bring along the load tile they used, which is often set up already.
+                if self.emittedTiles.get(parse_tile(args[4])) == command:
+                    continue
+                self.emittedTiles[parse_tile(args[4])] = command
+            elif macro in TEXTURE_LOAD_MACROS or macro in MULTI_LOAD_MACROS \
+                    or macro in ("gsDPSetOtherMode", "gsSPDisplayList", "gsSPBranchList"):
+                self.emittedTiles = {}
+            commands.append(command)
+        self.entries = []
+
+        if any(not macro.startswith("gsSP") or macro in ("gsSPDisplayList", "gsSPBranchList")
+               for macro, args in commands):
+            syncs = [("gsDPPipeSync", [])]
+            if any(macro in ("gsDPSetTile", "gsDPSetTileSize") for macro, args in commands):
+                syncs.append(("gsDPTileSync", []))
+            commands = syncs + commands
+        return [format_command(c) for c in commands]
+
+
+class Segment:
+    """Render state commands, followed by the triangles drawn with that state."""
+
+    def __init__(self):
+        self.state = []
+        self.triangles = []
+
+
+def has_geometry(name, gfxArrays):
+    """Whether a display list, or one it calls from the same file, draws triangles."""
+    for macro, args in gfxArrays[name]:
+        if macro == "gsSPVertex":
+            return True
+        if macro in ("gsSPDisplayList", "gsSPBranchList") and args[0] in gfxArrays and has_geometry(args[0], gfxArrays):
+            return True
+    return False
+
+
+def flatten(name, gfxArrays, vtxArrays, segments, vertexCache):
+    """
+    Walk a display list and split it into segments. Lists it calls from the same file are inlined if they draw
+    anything, and otherwise kept as calls.
+    """
+    for macro, args in gfxArrays[name]:
+        if macro == "gsSPEndDisplayList":
+            return
+        if macro in ("gsSPDisplayList", "gsSPBranchList") and args[0] in gfxArrays and has_geometry(args[0], gfxArrays):
+            flatten(args[0], gfxArrays, vtxArrays, segments, vertexCache)
+            if macro == "gsSPBranchList":
+                return
+        elif macro == "gsSPVertex":
+            ref = VTX_REF.match(args[0])
+            if ref is None or ref.group(1) not in vtxArrays:
+                sys.exit("%s: can't find the vertices %s" % (name, args[0]))
+            offset = parse_int(ref.group(2) or ref.group(3) or "0")
+            count = parse_int(args[1])
+            first = parse_int(args[2])
+            for i in range(count):
+                vertexCache[first + i] = vtxArrays[ref.group(1)][offset + i]
+        elif macro in ("gsSP1Triangle", "gsSP2Triangles", "gsSP1Quadrangle"):
+            indices = [parse_int(a) for a in args]
+            if macro == "gsSP1Triangle":
+                tris = [indices[0:3]]
+            elif macro == "gsSP2Triangles":
+                tris = [indices[0:3], indices[4:7]]
+            else:
+                tris = [indices[0:3], [indices[0], indices[2], indices[3]]]
+            for tri in tris:
+                segments[-1].triangles.append(tuple(vertexCache[i] for i in tri))
+        else:
+            if segments[-1].triangles:
+                segments.append(Segment())
+            segments[-1].state.append((macro, args))
+
+
+def tri_bounds(tri):
+    return ([min(v[0][i] for v in tri) for i in range(3)], [max(v[0][i] for v in tri) for i in range(3)])
+
+
+def merge_bounds(boxes):
+    return ([min(b[0][i] for b in boxes) for i in range(3)], [max(b[1][i] for b in boxes) for i in range(3)])
+
+
+def build_tree(chunks, leafSize):
+    """Group chunks into a tree of boxes by splitting them at the median of their longest axis."""
+    box = merge_bounds([c["bounds"] for c in chunks])
+    if len(chunks) <= leafSize:
+        return {"bounds": box, "chunks": chunks, "children": []}
+    centers = [[(c["bounds"][0][i] + c["bounds"][1][i]) / 2 for i in range(3)] for c in chunks]
+    axis = max(range(3), key=lambda i: max(p[i] for p in centers) - min(p[i] for p in centers))
+    order = sorted(range(len(chunks)), key=lambda i: centers[i][axis])
+    half = len(chunks) // 2
+    return {"bounds": box, "chunks": [], "children": [
+        build_tree([chunks[i] for i in order[:half]], leafSize),
+        build_tree([chunks[i] for i in order[half:]], leafSize),
+    ]}
+
+
+def format_vtx(v):
+    pos, flag, st, color = v
+    return "    {{{%6d, %6d, %6d}, %d, {%6d, %6d}, {0x%02x, 0x%02x, 0x%02x, 0x%02x}}}," % (
+        pos[0], pos[1], pos[2], flag, st[0], st[1], color[0] & 0xFF, color[1] & 0xFF, color[2] & 0xFF, color[3] & 0xFF)
+
+
+def write_chunk(out, name, segments, cellTris, cacheSize):
+    """Write the vertices and display list of one chunk. cellTris holds the triangles of each segment in this chunk."""
+    vertices = []
+    vertexIndex = {}
+    commands = []
+    state = RenderState()
+
+    for segment, tris in zip(segments, cellTris):
+        for command in segment.state:
+            state.add(command)
+        if not tris:
+            continue
+        commands += state.flush()
+
+        # Load as many vertices as fit in the vertex cache, then draw every triangle that uses them.
+        batch = []
+        batchTris = []
+
+        def flush():
+            if not batch:
+                return
+            first = len(vertices)
+            for v in batch:
+                vertices.append(v)
+            commands.append("gsSPVertex(%s_vtx + %d, %d, 0)" % (name, first, len(batch)))
+            for i in range(0, len(batchTris) - 1, 2):
+                a, b = batchTris[i], batchTris[i + 1]
+                commands.append("gsSP2Triangles(%d, %d, %d, 0, %d, %d, %d, 0)" % (a + b))
+            if len(batchTris) % 2:
+                commands.append("gsSP1Triangle(%d, %d, %d, 0)" % batchTris[-1])
+            batch.clear()
+            batchTris.clear()
+            vertexIndex.clear()
+
+        for tri in tris:
+            if len(set(v for v in tri if v not in vertexIndex)) + len(batch) > cacheSize:
+                flush()
+            indices = []
+            for v in tri:
+                if v not in vertexIndex:
+                    vertexIndex[v] = len(batch)
+                    batch.append(v)
+                indices.append(vertexIndex[v])
+            batchTris.append(tuple(indices))
+        flush()
+    commands += state.flush(end=True)
+
+    out.write("static const Vtx %s_vtx[] = {\n" % name)
+    for v in vertices:
+        out.write(format_vtx(v) + "\n")
+    out.write("};\n\n")
+    out.write("const Gfx %s[] = {\n" % name)
+    for command in commands:
+        out.write("    %s,\n" % command)
+    out.write("    gsSPEndDisplayList(),\n};\n\n")
+
+
+def write_geo(out, node, layer, indent):
+    pad = "    " * indent
+    lo, hi = node["bounds"]
+    clamp = lambda x: max(S16_MIN, min(S16_MAX, x))
+    out.write("%sGEO_CULLING_BOX(%d, %d, %d, %d, %d, %d),\n" % ((pad,) + tuple(clamp(x) for x in lo + hi)))
+    out.write("%sGEO_OPEN_NODE(),\n" % pad)
+    for child in node["children"]:
+        write_geo(out, child, layer, indent + 1)
+    for chunk in node["chunks"]:
+        out.write("%s    GEO_DISPLAY_LIST(%s, %s),\n" % (pad, layer, chunk["name"]))
+    out.write("%sGEO_CLOSE_NODE(),\n" % pad)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Split a level display list into culled chunks.")
+    parser.add_argument("source", help="C file with the display list and its vertices")
+    parser.add_argument("dl", help="name of the display list to split")
+    parser.add_argument("--cell-size", type=int, default=2000, help="size of each grid cell (default: 2000)")
+    parser.add_argument("--layer", default="LAYER_OPAQUE", help="layer of the display list (default: LAYER_OPAQUE)")
+    parser.add_argument("--leaf-size", type=int, default=1, help="most chunks under one box (default: 1)")
+    parser.add_argument("--vertex-cache", type=int, default=32, help="vertices per gsSPVertex (default: 32)")
+    parser.add_argument("--out-dl", required=True, help="output C file for the chunk display lists")
+    parser.add_argument("--out-geo", required=True, help="output geo layout snippet")
+    args = parser.parse_args()
+
+    with open(args.source) as f:
+        vtxArrays, gfxArrays = parse_source(f.read())
+    if args.dl not in gfxArrays:
+        sys.exit("%s: no display list named %s" % (args.source, args.dl))
+
+    segments = [Segment()]
+    flatten(args.dl, gfxArrays, vtxArrays, segments, {})
+
+    # Sort the triangles of each segment into grid cells by their centres.
+    cells = {}
+    for s, segment in enumerate(segments):
+        for tri in segment.triangles:
+            center = [sum(v[0][i] for v in tri) / 3 for i in range(3)]
+            key = tuple(int(c // args.cell_size) for c in center)
+            cells.setdefault(key, [[] for _ in segments])[s].append(tri)
+
+    if not cells:
+        sys.exit("%s has no triangles" % args.dl)
+
+    chunks = []
+    with open(args.out_dl, "w") as out:
+        out.write("// Generated by tools/chunk_level_geometry.py from %s\n\n" % args.dl)
+        for i, key in enumerate(sorted(cells)):
+            name = "%s_chunk_%d" % (args.dl, i)
+            cellTris = cells[key]
+            write_chunk(out, name, segments, cellTris, args.vertex_cache)
+            chunks.append({"name": name, "bounds": merge_bounds([tri_bounds(t) for tris in cellTris for t in tris])})
+
+    with open(args.out_geo, "w") as out:
+        out.write("// Generated by tools/chunk_level_geometry.py from %s\n" % args.dl)
+        write_geo(out, build_tree(chunks, args.leaf_size), args.layer, 0)
+
+    print("%s: %d triangles in %d chunks" % (args.dl, sum(len(s.triangles) for s in segments), len(chunks)))
+
+
+if __name__ == "__main__":
+    main()
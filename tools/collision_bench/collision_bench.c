@@ -0,0 +1,870 @@
+/**
+ * Host-native collision benchmark.
+ *
+ * Loads an area's static collision through load_area_terrain() exactly like the game does,
+ * then replays a set of find_floor/find_ceil/find_wall_collisions/find_surface_on_ray queries
+ * against it and reports queries per second and how long the partition lists that the
+ * queries walked were.
+ *
+ * Queries either come from a trace file (-t) or are generated from the area's own surfaces
+ * with a fixed seed, so that runs are reproducible and can be saved (-w) for A/B comparisons
+ * of partition changes. Every query result is folded into a checksum: two builds that report
+ * the same checksum for the same trace returned the same surfaces and heights.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <ultra64.h>
+#include "sm64.h"
+#include "object_fields.h"
+#include "surface_terrains.h"
+#include "engine/math_util.h"
+#include "engine/surface_collision.h"
+#include "engine/surface_load.h"
+#include "game/object_helpers.h"
+#include "game/object_list_processor.h"
+
+#include "collision_bench.h"
+
+#define DEFAULT_NUM_QUERIES 1000000
+#define DEFAULT_SEED        0x5EED5EED
+#define DEFAULT_NUM_FRAMES  1000
+#define DEFAULT_MOVE_PERCENT 25
+#define REPORT_TOP_CELLS    5
+
+static const char *sQueryTypeNames[COLLISION_QUERY_TYPE_COUNT] = { "floor", "ceil", "wall", "ray" };
+static const char *sPartitionNames[NUM_SPATIAL_PARTITIONS] = { "floors", "ceils", "walls", "water" };
+
+struct BenchOptions {
+    u32 numQueries;
+    u32 repeats;
+    u32 seed;
+    u32 typeMask;
+    u32 cellReport;
+    u32 numObjects;
+    u32 movePercent;
+    u32 numFrames;
+    const char *traceIn;
+    const char *traceOut;
+};
+
+struct SurfaceSet {
+    struct Surface **surfaces[NUM_SPATIAL_PARTITIONS];
+    u32 count[NUM_SPATIAL_PARTITIONS];
+};
+
+struct QueryResult {
+    u32 count;
+    f64 seconds;
+    u64 nodesWalked;
+    u32 checksum;
+};
+
+/**************************************************
+ *                    UTILITIES                   *
+ **************************************************/
+
+static u32 sRandState;
+
+static u32 bench_random_u32(void) {
+    // xorshift32
+    sRandState ^= sRandState << 13;
+    sRandState ^= sRandState >> 17;
+    sRandState ^= sRandState << 5;
+    return sRandState;
+}
+
+static f32 bench_random_f32(f32 lo, f32 hi) {
+    return lo + (hi - lo) * ((bench_random_u32() >> 8) * (1.0f / 16777216.0f));
+}
+
+static f64 bench_time_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static u32 hash_bytes(u32 hash, const void *data, size_t size) {
+    const u8 *bytes = data;
+    while (size--) {
+        hash = (hash ^ *bytes++) * 16777619u; // FNV-1a
+    }
+    return hash;
+}
+
+static u32 hash_surface(u32 hash, struct Surface *surf) {
+    if (surf == NULL) {
+        return hash_bytes(hash, "null", 4);
+    }
+    hash = hash_bytes(hash, &surf->type, sizeof(surf->type));
+    hash = hash_bytes(hash, surf->vertex1, sizeof(surf->vertex1));
+    hash = hash_bytes(hash, surf->vertex2, sizeof(surf->vertex2));
+    return hash_bytes(hash, surf->vertex3, sizeof(surf->vertex3));
+}
+
+static u32 list_length(struct SurfaceNode *node) {
+    u32 count = 0;
+    while (node != NULL) {
+        node = node->next;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Number of static surfaces in a cell, optionally writing them to `out`.
+ */
+static u32 static_cell_surfaces(s32 cellZ, s32 cellX, s32 listIndex, struct Surface **out) {
+    u32 count = 0;
+
+#ifdef FLAT_STATIC_PARTITION
+    struct Surface **array = STATIC_SURFACE_ARRAY(cellZ, cellX, listIndex);
+    for (struct Surface *surf = array[0]; surf < array[1]; surf++) {
+        if (out != NULL) {
+            out[count] = STATIC_SURFACE_ORIGIN(surf);
+        }
+        count++;
+    }
+#endif
+
+    struct SurfaceNode *node = gStaticSurfacePartition[cellZ][cellX][listIndex];
+    for (; node != NULL; node = node->next) {
+        if (out != NULL) {
+            out[count] = node->surface;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Number of surface nodes a query at (x, z) walks in the given partition, static and dynamic.
+ */
+static u32 cell_nodes(s32 x, s32 z, s32 radius, s32 listIndex) {
+    u32 count = 0;
+
+    if (is_outside_level_bounds(x, z)) {
+        return 0;
+    }
+
+    s32 minCellX = GET_CELL_COORD(x - radius);
+    s32 minCellZ = GET_CELL_COORD(z - radius);
+    s32 maxCellX = GET_CELL_COORD(x + radius);
+    s32 maxCellZ = GET_CELL_COORD(z + radius);
+
+    for (s32 cellX = minCellX; cellX <= maxCellX; cellX++) {
+        for (s32 cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            count += static_cell_surfaces(cellZ, cellX, listIndex, NULL);
+            count += list_length(gDynamicSurfacePartition[cellZ][cellX][listIndex]);
+        }
+    }
+
+    return count;
+}
+
+/**************************************************
+ *                 LEVEL LOADING                  *
+ **************************************************/
+
+static s32 compare_pointers(const void *a, const void *b) {
+    uintptr_t pa = *(const uintptr_t *) a;
+    uintptr_t pb = *(const uintptr_t *) b;
+    return (pa > pb) - (pa < pb);
+}
+
+/**
+ * Gather the unique surfaces of each partition type, used as seeds for generated queries.
+ */
+static void collect_surfaces(struct SurfaceSet *set) {
+    for (s32 listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+        u32 total = 0;
+        for (s32 cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+            for (s32 cellX = 0; cellX < NUM_CELLS; cellX++) {
+                total += static_cell_surfaces(cellZ, cellX, listIndex, NULL);
+            }
+        }
+
+        struct Surface **surfaces = malloc(MAX(total, 1u) * sizeof(struct Surface *));
+        u32 count = 0;
+        for (s32 cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+            for (s32 cellX = 0; cellX < NUM_CELLS; cellX++) {
+                count += static_cell_surfaces(cellZ, cellX, listIndex, &surfaces[count]);
+            }
+        }
+
+        qsort(surfaces, count, sizeof(struct Surface *), compare_pointers);
+        u32 unique = 0;
+        for (u32 i = 0; i < count; i++) {
+            if (unique == 0 || surfaces[unique - 1] != surfaces[i]) {
+                surfaces[unique++] = surfaces[i];
+            }
+        }
+
+        set->surfaces[listIndex] = surfaces;
+        set->count[listIndex] = unique;
+    }
+}
+
+static void free_surfaces(struct SurfaceSet *set) {
+    for (s32 listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+        free(set->surfaces[listIndex]);
+    }
+}
+
+static f64 load_level(const struct BenchLevel *level) {
+    bench_reset_main_pool();
+    alloc_surface_pools();
+
+    f64 start = bench_time_seconds();
+    load_area_terrain(0, (TerrainData *) level->collision, NULL, NULL);
+    f64 loadTime = bench_time_seconds() - start;
+
+    // Drop the previous area's object surfaces, as the first frame in the area would.
+    clear_dynamic_surfaces();
+    return loadTime;
+}
+
+/**************************************************
+ *                    QUERIES                     *
+ **************************************************/
+
+static void random_point_on_surface(Vec3f dest, struct Surface *surf) {
+    f32 u = bench_random_f32(0.0f, 1.0f);
+    f32 v = bench_random_f32(0.0f, 1.0f);
+    if (u + v > 1.0f) {
+        u = 1.0f - u;
+        v = 1.0f - v;
+    }
+
+    for (s32 i = 0; i < 3; i++) {
+        dest[i] = surf->vertex1[i]
+                + u * (surf->vertex2[i] - surf->vertex1[i])
+                + v * (surf->vertex3[i] - surf->vertex1[i]);
+    }
+}
+
+static struct Surface *random_surface(struct SurfaceSet *set, s32 listIndex) {
+    if (set->count[listIndex] == 0) {
+        return NULL;
+    }
+    return set->surfaces[listIndex][bench_random_u32() % set->count[listIndex]];
+}
+
+/**
+ * A point somewhere on the walkable part of the level, or anywhere in bounds if there are no floors.
+ */
+static void random_standing_point(Vec3f dest, struct SurfaceSet *set) {
+    struct Surface *floor = random_surface(set, SPATIAL_PARTITION_FLOORS);
+
+    if (floor != NULL) {
+        random_point_on_surface(dest, floor);
+    } else {
+        dest[0] = bench_random_f32(-LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX);
+        dest[1] = bench_random_f32(FLOOR_LOWER_LIMIT, CELL_HEIGHT_LIMIT);
+        dest[2] = bench_random_f32(-LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX);
+    }
+}
+
+/**
+ * Generate a query of the given type the way gameplay code tends to issue them:
+ * floors and ceilings around standing height, walls near actual walls at Mario's
+ * two wall check heights, and camera-length rays.
+ */
+static void generate_query(struct CollisionQuery *query, s32 type, struct SurfaceSet *set) {
+    struct Surface *surf;
+
+    bzero(query, sizeof(*query));
+    query->type = type;
+
+    switch (type) {
+        case COLLISION_QUERY_FLOOR:
+            random_standing_point(query->pos, set);
+            query->pos[1] += bench_random_f32(-20.0f, 300.0f);
+            break;
+
+        case COLLISION_QUERY_CEIL:
+            surf = random_surface(set, SPATIAL_PARTITION_CEILS);
+            if (surf != NULL && (bench_random_u32() & 1)) {
+                random_point_on_surface(query->pos, surf);
+                query->pos[1] -= bench_random_f32(0.0f, 300.0f);
+            } else {
+                random_standing_point(query->pos, set);
+                query->pos[1] += 160.0f;
+            }
+            break;
+
+        case COLLISION_QUERY_WALL:
+            surf = random_surface(set, SPATIAL_PARTITION_WALLS);
+            if (surf != NULL) {
+                random_point_on_surface(query->pos, surf);
+                f32 push = bench_random_f32(-40.0f, 60.0f);
+                query->pos[0] += surf->normal.x * push;
+                query->pos[2] += surf->normal.z * push;
+            } else {
+                random_standing_point(query->pos, set);
+            }
+            if (bench_random_u32() & 1) {
+                query->arg[0] = 30.0f;
+                query->arg[1] = 24.0f;
+            } else {
+                query->arg[0] = 60.0f;
+                query->arg[1] = 50.0f;
+            }
+            query->pos[1] -= query->arg[0];
+            break;
+
+        case COLLISION_QUERY_RAY:
+            random_standing_point(query->pos, set);
+            query->pos[1] += bench_random_f32(50.0f, 300.0f);
+            {
+                s16 yaw = bench_random_u32();
+                s16 pitch = bench_random_f32(-0x1000, 0x1000);
+                f32 length = bench_random_f32(200.0f, 2000.0f);
+                query->arg[0] = coss(pitch) * sins(yaw) * length;
+                query->arg[1] = sins(pitch) * length;
+                query->arg[2] = coss(pitch) * coss(yaw) * length;
+            }
+            query->flags = (RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
+            break;
+    }
+}
+
+// Rough per-frame mix: floor checks dominate, then walls, ceilings and camera rays.
+static const u8 sQueryMix[] = {
+    COLLISION_QUERY_FLOOR, COLLISION_QUERY_FLOOR, COLLISION_QUERY_FLOOR, COLLISION_QUERY_FLOOR,
+    COLLISION_QUERY_FLOOR, COLLISION_QUERY_FLOOR, COLLISION_QUERY_FLOOR, COLLISION_QUERY_FLOOR,
+    COLLISION_QUERY_FLOOR, COLLISION_QUERY_CEIL,  COLLISION_QUERY_CEIL,  COLLISION_QUERY_CEIL,
+    COLLISION_QUERY_CEIL,  COLLISION_QUERY_WALL,  COLLISION_QUERY_WALL,  COLLISION_QUERY_WALL,
+    COLLISION_QUERY_WALL,  COLLISION_QUERY_WALL,  COLLISION_QUERY_RAY,   COLLISION_QUERY_RAY,
+};
+
+static struct CollisionQuery *generate_queries(struct SurfaceSet *set, u32 count, u32 seed, u32 typeMask) {
+    struct CollisionQuery *queries = malloc(MAX(count, 1u) * sizeof(struct CollisionQuery));
+    sRandState = (seed != 0) ? seed : DEFAULT_SEED;
+
+    for (u32 i = 0; i < count; i++) {
+        s32 type;
+        do {
+            type = sQueryMix[bench_random_u32() % ARRAY_COUNT(sQueryMix)];
+        } while (!(typeMask & (1 << type)));
+        generate_query(&queries[i], type, set);
+    }
+
+    return queries;
+}
+
+static struct CollisionQuery *read_trace(const char *path, u32 *count, char *level) {
+    struct CollisionTraceHeader header;
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL) {
+        perror(path);
+        return NULL;
+    }
+
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, COLLISION_TRACE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != COLLISION_TRACE_VERSION) {
+        fprintf(stderr, "%s: not a collision trace\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    struct CollisionQuery *queries = malloc(MAX(header.count, 1u) * sizeof(struct CollisionQuery));
+    if (fread(queries, sizeof(struct CollisionQuery), header.count, file) != header.count) {
+        fprintf(stderr, "%s: truncated trace\n", path);
+        free(queries);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    *count = header.count;
+    memcpy(level, header.level, sizeof(header.level));
+    level[sizeof(header.level) - 1] = '\0';
+    return queries;
+}
+
+static s32 write_trace(const char *path, const char *level, struct CollisionQuery *queries, u32 count) {
+    struct CollisionTraceHeader header;
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL) {
+        perror(path);
+        return FALSE;
+    }
+
+    bzero(&header, sizeof(header));
+    memcpy(header.magic, COLLISION_TRACE_MAGIC, sizeof(header.magic));
+    header.version = COLLISION_TRACE_VERSION;
+    header.count = count;
+    strncpy(header.level, level, sizeof(header.level) - 1);
+
+    s32 ok = fwrite(&header, sizeof(header), 1, file) == 1
+          && fwrite(queries, sizeof(struct CollisionQuery), count, file) == count;
+    fclose(file);
+    return ok;
+}
+
+/**
+ * Run one query against the engine, folding its result into the checksum.
+ */
+static ALWAYS_INLINE u32 run_query(struct CollisionQuery *query, u32 hash) {
+    struct Surface *surf;
+    struct WallCollisionData walls;
+    Vec3f hitPos;
+    f32 height;
+
+    switch (query->type) {
+        case COLLISION_QUERY_FLOOR:
+            height = find_floor(query->pos[0], query->pos[1], query->pos[2], &surf);
+            hash = hash_bytes(hash, &height, sizeof(height));
+            return hash_surface(hash, surf);
+
+        case COLLISION_QUERY_CEIL:
+            height = find_ceil(query->pos[0], query->pos[1], query->pos[2], &surf);
+            hash = hash_bytes(hash, &height, sizeof(height));
+            return hash_surface(hash, surf);
+
+        case COLLISION_QUERY_WALL:
+            walls.x = query->pos[0];
+            walls.y = query->pos[1];
+            walls.z = query->pos[2];
+            walls.offsetY = query->arg[0];
+            walls.radius = query->arg[1];
+            s32 numCollisions = find_wall_collisions(&walls);
+            hash = hash_bytes(hash, &numCollisions, sizeof(numCollisions));
+            hash = hash_bytes(hash, &walls.x, sizeof(walls.x));
+            hash = hash_bytes(hash, &walls.z, sizeof(walls.z));
+            for (s32 i = 0; i < walls.numWalls; i++) {
+                hash = hash_surface(hash, walls.walls[i]);
+            }
+            return hash;
+
+        case COLLISION_QUERY_RAY:
+            surf = NULL;
+            vec3_zero(hitPos);
+            find_surface_on_ray(query->pos, query->arg, &surf, hitPos, query->flags);
+            hash = hash_bytes(hash, hitPos, sizeof(hitPos));
+            return hash_surface(hash, surf);
+    }
+
+    return hash;
+}
+
+static u32 query_nodes_walked(struct CollisionQuery *query) {
+    switch (query->type) {
+        case COLLISION_QUERY_FLOOR: return cell_nodes(query->pos[0], query->pos[2], 0, SPATIAL_PARTITION_FLOORS);
+        case COLLISION_QUERY_CEIL:  return cell_nodes(query->pos[0], query->pos[2], 0, SPATIAL_PARTITION_CEILS);
+        case COLLISION_QUERY_WALL:  return cell_nodes(query->pos[0], query->pos[2], query->arg[1], SPATIAL_PARTITION_WALLS);
+        default:                    return 0;
+    }
+}
+
+/**
+ * Replay all queries of one type, `repeats` times, and time them.
+ */
+static void run_queries(struct QueryResult *result, struct CollisionQuery *queries, u32 count, s32 type, u32 repeats) {
+    struct CollisionQuery *subset = malloc(MAX(count, 1u) * sizeof(struct CollisionQuery));
+    u32 n = 0;
+
+    for (u32 i = 0; i < count; i++) {
+        if (queries[i].type == type) {
+            subset[n++] = queries[i];
+        }
+    }
+
+    bzero(result, sizeof(*result));
+    result->checksum = 2166136261u;
+
+    for (u32 i = 0; i < n; i++) {
+        result->nodesWalked += query_nodes_walked(&subset[i]);
+    }
+
+    f64 start = bench_time_seconds();
+    for (u32 r = 0; r < repeats; r++) {
+        u32 hash = 2166136261u;
+        for (u32 i = 0; i < n; i++) {
+            hash = run_query(&subset[i], hash);
+        }
+        result->checksum = hash;
+    }
+    result->seconds = bench_time_seconds() - start;
+    result->count = n * repeats;
+
+    free(subset);
+}
+
+/**************************************************
+ *                DYNAMIC SURFACES                *
+ **************************************************/
+
+/**
+ * A 400x400 platform, 100 units thick, laid out like an object's collision.inc.c.
+ */
+static const Collision sPlatformCollision[] = {
+    COL_INIT(),
+    COL_VERTEX_INIT(8),
+    COL_VERTEX(-200,    0, -200),
+    COL_VERTEX( 200,    0, -200),
+    COL_VERTEX( 200,    0,  200),
+    COL_VERTEX(-200,    0,  200),
+    COL_VERTEX(-200, -100, -200),
+    COL_VERTEX( 200, -100, -200),
+    COL_VERTEX( 200, -100,  200),
+    COL_VERTEX(-200, -100,  200),
+    COL_TRI_INIT(SURFACE_DEFAULT, 12),
+    COL_TRI(0, 3, 2),
+    COL_TRI(0, 2, 1),
+    COL_TRI(4, 5, 6),
+    COL_TRI(4, 6, 7),
+    COL_TRI(0, 1, 5),
+    COL_TRI(0, 5, 4),
+    COL_TRI(1, 2, 6),
+    COL_TRI(1, 6, 5),
+    COL_TRI(2, 3, 7),
+    COL_TRI(2, 7, 6),
+    COL_TRI(3, 0, 4),
+    COL_TRI(3, 4, 7),
+    COL_TRI_STOP(),
+    COL_END(),
+};
+
+struct DynamicResult {
+    u32 numObjects;
+    u32 frames;
+    f64 seconds;
+    u32 checksum;
+};
+
+/**
+ * Simulate the surface object update: every frame, clear the dynamic surfaces and have each platform
+ * load its collision, with a share of them moving. The time spent loading is measured, and a floor
+ * check above each platform is folded into the checksum so that partition changes can be compared.
+ */
+static void run_dynamic_frames(struct DynamicResult *result, struct SurfaceSet *set, struct BenchOptions *options) {
+    struct Object *mario = &gObjectPool[OBJECT_POOL_CAPACITY - 1];
+    // Keep the platforms within the dynamic surface pool, even if each one straddles four cells.
+    u32 platformSize = (12 * sizeof(struct Surface)) + (4 * 12 * sizeof(struct SurfaceNode)) + 0x80;
+    u32 numObjects = MIN(options->numObjects, MIN(OBJECT_POOL_CAPACITY - 1u, DYNAMIC_SURFACE_POOL_SIZE / platformSize));
+    u32 numMoving = numObjects * options->movePercent / 100;
+    struct Object *obj;
+    struct Surface *floor;
+    f32 height;
+
+    bzero(gObjectPool, sizeof(struct Object) * OBJECT_POOL_CAPACITY);
+    gMarioObject = mario;
+    sRandState = options->seed;
+
+    for (u32 i = 0; i < numObjects; i++) {
+        obj = &gObjectPool[i];
+        random_standing_point(&obj->oPosVec, set);
+        obj->oPosY += 200.0f;
+        obj->oFaceAngleYaw = bench_random_u32();
+        obj->collisionData = (void *) sPlatformCollision;
+        obj->oFlags = OBJ_FLAG_DONT_CALC_COLL_DIST;
+        obj->oCollisionDistance = (4.0f * LEVEL_BOUNDARY_MAX);
+        obj->activeFlags = ACTIVE_FLAG_ACTIVE;
+        vec3f_set(obj->header.gfx.scale, 1.0f, 1.0f, 1.0f);
+    }
+
+    result->numObjects = numObjects;
+    result->frames = options->numFrames;
+    result->seconds = 0.0;
+    result->checksum = 2166136261u;
+
+    for (u32 frame = 0; frame < options->numFrames; frame++) {
+        f64 start = bench_time_seconds();
+
+        clear_dynamic_surfaces();
+        for (u32 i = 0; i < numObjects; i++) {
+            obj = &gObjectPool[i];
+            if (i < numMoving) {
+                obj->oPosY += ((frame + i) & 1) ? 10.0f : -10.0f;
+                obj_build_transform_from_pos_and_angle(obj, O_POS_INDEX, O_FACE_ANGLE_INDEX);
+            }
+            gCurrentObject = obj;
+            load_object_collision_model();
+        }
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+        unload_stale_dynamic_surfaces();
+#endif
+
+        result->seconds += bench_time_seconds() - start;
+
+        for (u32 i = 0; i < numObjects; i++) {
+            obj = &gObjectPool[i];
+            height = find_floor(obj->oPosX, obj->oPosY + 50.0f, obj->oPosZ, &floor);
+            result->checksum = hash_bytes(result->checksum, &height, sizeof(height));
+            result->checksum = hash_surface(result->checksum, floor);
+        }
+    }
+
+    gCurrentObject = NULL;
+    gMarioObject = NULL;
+}
+
+/**************************************************
+ *                   REPORTING                    *
+ **************************************************/
+
+struct CellLength {
+    u16 x, z;
+    u32 length;
+};
+
+static s32 compare_cell_length(const void *a, const void *b) {
+    const struct CellLength *ca = a;
+    const struct CellLength *cb = b;
+    return (ca->length < cb->length) - (ca->length > cb->length);
+}
+
+/**
+ * Per-partition list lengths over all cells of the static partition.
+ */
+static void print_cell_report(void) {
+    static struct CellLength cells[NUM_CELLS * NUM_CELLS];
+
+    for (s32 listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+        u32 numCells = 0;
+        u64 total = 0;
+
+        for (s32 cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+            for (s32 cellX = 0; cellX < NUM_CELLS; cellX++) {
+                u32 length = static_cell_surfaces(cellZ, cellX, listIndex, NULL);
+                if (length != 0) {
+                    cells[numCells].x = cellX;
+                    cells[numCells].z = cellZ;
+                    cells[numCells].length = length;
+                    numCells++;
+                    total += length;
+                }
+            }
+        }
+
+        qsort(cells, numCells, sizeof(struct CellLength), compare_cell_length);
+
+        printf("    %-6s %4u/%u cells used, %6llu nodes, mean %6.1f, max %4u |",
+               sPartitionNames[listIndex], numCells, NUM_CELLS * NUM_CELLS, (unsigned long long) total,
+               numCells ? (f64) total / numCells : 0.0, numCells ? cells[0].length : 0);
+        for (u32 i = 0; i < MIN(numCells, (u32) REPORT_TOP_CELLS); i++) {
+            printf(" (%2u,%2u)=%u", cells[i].x, cells[i].z, cells[i].length);
+        }
+        printf("\n");
+    }
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [options] [level...]\n"
+           "\n"
+           "Levels are named <level>/<area> (e.g. bob/1); a bare level name selects all of its areas.\n"
+           "All areas are benchmarked if none are given.\n"
+           "\n"
+           "Options:\n"
+           "  -n <count>   number of generated queries per area (default %d)\n"
+           "  -r <count>   replay the queries this many times (default 1)\n"
+           "  -s <seed>    random seed for generated queries\n"
+           "  -q <types>   query types to run, any of 'f'loor 'c'eil 'w'all 'r'ay (default fcwr)\n"
+           "  -t <file>    replay a recorded trace instead of generating queries\n"
+           "  -w <file>    write the generated queries for a single area to a trace\n"
+           "  -c           print per-cell list lengths for each area\n"
+           "  -d <count>   also time loading the collision of this many platform objects each frame\n"
+           "  -m <percent> share of the platforms that move every frame (default %d)\n"
+           "  -f <count>   number of frames to simulate with -d (default %d)\n"
+           "  -l           list available areas\n",
+           prog, DEFAULT_NUM_QUERIES, DEFAULT_MOVE_PERCENT, DEFAULT_NUM_FRAMES);
+}
+
+static s32 level_selected(const char *name, char **selected, s32 numSelected) {
+    if (numSelected == 0) {
+        return TRUE;
+    }
+
+    for (s32 i = 0; i < numSelected; i++) {
+        size_t len = strlen(selected[i]);
+        if (strcmp(name, selected[i]) == 0 || (strncmp(name, selected[i], len) == 0 && name[len] == '/')) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static u32 parse_query_types(const char *str) {
+    u32 mask = 0;
+    for (; *str != '\0'; str++) {
+        switch (*str) {
+            case 'f': mask |= (1 << COLLISION_QUERY_FLOOR); break;
+            case 'c': mask |= (1 << COLLISION_QUERY_CEIL);  break;
+            case 'w': mask |= (1 << COLLISION_QUERY_WALL);  break;
+            case 'r': mask |= (1 << COLLISION_QUERY_RAY);   break;
+        }
+    }
+    return mask;
+}
+
+int main(int argc, char **argv) {
+    struct BenchOptions options = {
+        .numQueries = DEFAULT_NUM_QUERIES,
+        .repeats = 1,
+        .seed = DEFAULT_SEED,
+        .typeMask = (1 << COLLISION_QUERY_TYPE_COUNT) - 1,
+        .movePercent = DEFAULT_MOVE_PERCENT,
+        .numFrames = DEFAULT_NUM_FRAMES,
+    };
+    struct QueryResult totals[COLLISION_QUERY_TYPE_COUNT];
+    s32 opt;
+
+    while ((opt = getopt(argc, argv, "n:r:s:q:t:w:cd:m:f:lh")) != -1) {
+        switch (opt) {
+            case 'n': options.numQueries = strtoul(optarg, NULL, 0); break;
+            case 'r': options.repeats = MAX(strtoul(optarg, NULL, 0), 1ul); break;
+            case 's': options.seed = strtoul(optarg, NULL, 0); break;
+            case 'q': options.typeMask = parse_query_types(optarg); break;
+            case 't': options.traceIn = optarg; break;
+            case 'w': options.traceOut = optarg; break;
+            case 'c': options.cellReport = TRUE; break;
+            case 'd': options.numObjects = strtoul(optarg, NULL, 0); break;
+            case 'm': options.movePercent = MIN(strtoul(optarg, NULL, 0), 100ul); break;
+            case 'f': options.numFrames = strtoul(optarg, NULL, 0); break;
+            case 'l':
+                for (const struct BenchLevel *level = gBenchLevels; level->name != NULL; level++) {
+                    printf("%s\n", level->name);
+                }
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (options.typeMask == 0) {
+        fprintf(stderr, "No query types selected\n");
+        return 1;
+    }
+
+    char **selected = &argv[optind];
+    s32 numSelected = argc - optind;
+
+    struct CollisionQuery *traceQueries = NULL;
+    u32 traceCount = 0;
+    char traceLevel[32];
+    char *traceSelection[] = { traceLevel };
+    if (options.traceIn != NULL) {
+        traceQueries = read_trace(options.traceIn, &traceCount, traceLevel);
+        if (traceQueries == NULL) {
+            return 1;
+        }
+        // A trace belongs to the area it was recorded in.
+        selected = traceSelection;
+        numSelected = 1;
+    }
+
+    bzero(totals, sizeof(totals));
+    s32 numLevels = 0;
+
+    printf("%-22s %6s %6s %8s", "area", "surfs", "nodes", "load ms");
+    for (s32 type = 0; type < COLLISION_QUERY_TYPE_COUNT; type++) {
+        if (options.typeMask & (1 << type)) {
+            printf(" | %-5s Mq/s walk", sQueryTypeNames[type]);
+        }
+    }
+    printf(" | checksum\n");
+
+    for (const struct BenchLevel *level = gBenchLevels; level->name != NULL; level++) {
+        if (!level_selected(level->name, selected, numSelected)) {
+            continue;
+        }
+
+        struct SurfaceSet set;
+        f64 loadTime = load_level(level);
+        collect_surfaces(&set);
+
+        struct CollisionQuery *queries = traceQueries;
+        u32 count = traceCount;
+        if (queries == NULL) {
+            count = options.numQueries;
+            queries = generate_queries(&set, count, options.seed, options.typeMask);
+        }
+
+        if (options.traceOut != NULL) {
+            if (numSelected != 1 || !write_trace(options.traceOut, level->name, queries, count)) {
+                fprintf(stderr, "Could not write trace (select exactly one area with -w)\n");
+                return 1;
+            }
+            options.traceOut = NULL;
+        }
+
+        printf("%-22s %6d %6d %8.3f", level->name, gNumStaticSurfaces, gNumStaticSurfaceNodes, loadTime * 1000.0);
+
+        u32 checksum = 2166136261u;
+        for (s32 type = 0; type < COLLISION_QUERY_TYPE_COUNT; type++) {
+            if (!(options.typeMask & (1 << type))) {
+                continue;
+            }
+
+            struct QueryResult result;
+            run_queries(&result, queries, count, type, options.repeats);
+            checksum = hash_bytes(checksum, &result.checksum, sizeof(result.checksum));
+
+            u32 numUnique = result.count / options.repeats;
+            printf(" | %10.2f", result.seconds > 0.0 ? result.count / result.seconds / 1e6 : 0.0);
+            if (type == COLLISION_QUERY_RAY) {
+                printf("    -");
+            } else {
+                printf(" %4.1f", numUnique ? (f64) result.nodesWalked / numUnique : 0.0);
+            }
+
+            totals[type].count += result.count;
+            totals[type].seconds += result.seconds;
+            totals[type].nodesWalked += result.nodesWalked;
+        }
+        printf(" | %08x\n", checksum);
+
+        if (options.cellReport) {
+            print_cell_report();
+        }
+
+        if (options.numObjects != 0) {
+            struct DynamicResult dynamic;
+            run_dynamic_frames(&dynamic, &set, &options);
+            printf("    %u platforms, %u%% moving: %.2f us/frame | %08x\n",
+                   dynamic.numObjects, options.movePercent,
+                   dynamic.frames ? dynamic.seconds * 1e6 / dynamic.frames : 0.0, dynamic.checksum);
+        }
+
+        if (queries != traceQueries) {
+            free(queries);
+        }
+        free_surfaces(&set);
+        numLevels++;
+    }
+
+    if (numLevels == 0) {
+        fprintf(stderr, "No matching areas (use -l to list them)\n");
+        return 1;
+    }
+
+    printf("\nTotal over %d area(s):\n", numLevels);
+    for (s32 type = 0; type < COLLISION_QUERY_TYPE_COUNT; type++) {
+        if (totals[type].count == 0) {
+            continue;
+        }
+        u32 numUnique = totals[type].count / options.repeats;
+        printf("  %-5s %10u queries %8.2f Mq/s %8.1f ns/query",
+               sQueryTypeNames[type], totals[type].count,
+               totals[type].count / totals[type].seconds / 1e6,
+               totals[type].seconds * 1e9 / totals[type].count);
+        if (type != COLLISION_QUERY_RAY) {
+            printf(", %.1f nodes walked/query", (f64) totals[type].nodesWalked / numUnique);
+        }
+        printf("\n");
+    }
+
+    free(traceQueries);
+    return 0;
+}
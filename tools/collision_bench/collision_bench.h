@@ -0,0 +1,55 @@
+#ifndef COLLISION_BENCH_H
+#define COLLISION_BENCH_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+/**
+ * An area's static collision, as included from levels/<level>/areas/<n>/collision.inc.c.
+ */
+struct BenchLevel {
+    const char *name;
+    const Collision *collision;
+};
+
+extern const struct BenchLevel gBenchLevels[];
+
+enum CollisionQueryType {
+    COLLISION_QUERY_FLOOR,
+    COLLISION_QUERY_CEIL,
+    COLLISION_QUERY_WALL,
+    COLLISION_QUERY_RAY,
+    COLLISION_QUERY_TYPE_COUNT
+};
+
+/**
+ * A single recorded collision query. Traces are a CollisionTraceHeader followed
+ * by `count` of these, in host byte order.
+ *   floor/ceil: pos
+ *   wall:       pos, arg[0] = offsetY, arg[1] = radius
+ *   ray:        pos = origin, arg = direction (unnormalized), flags = RaycastFlags
+ */
+struct CollisionQuery {
+    u8 type;
+    u8 pad[3];
+    s32 flags;
+    f32 pos[3];
+    f32 arg[3];
+};
+
+#define COLLISION_TRACE_MAGIC   "SM64COLQ"
+#define COLLISION_TRACE_VERSION 1
+
+struct CollisionTraceHeader {
+    char magic[8];
+    u32 version;
+    u32 count;
+    char level[32];
+};
+
+// engine_stubs.c
+void bench_reset_main_pool(void);
+u32 bench_main_pool_used(void);
+
+#endif // COLLISION_BENCH_H
@@ -0,0 +1,159 @@
+/**
+ * Minimal stand-ins for the parts of the game that the collision code touches,
+ * so that surface_collision.c, surface_load.c and math_util.c can be linked on the host.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ultra64.h>
+#include "sm64.h"
+#include "behavior_data.h"
+#include "special_presets.h"
+#include "engine/math_util.h"
+#include "engine/graph_node.h"
+#include "game/area.h"
+#include "game/camera.h"
+#include "game/level_update.h"
+#include "game/memory.h"
+#include "game/object_list_processor.h"
+
+#include "collision_bench.h"
+
+// Behaviors referenced by special_presets.h and surface_load.c.
+#include "bhv_stubs.inc.c"
+
+/**
+ * Game state read by the collision code.
+ */
+struct Object gObjectPool[OBJECT_POOL_CAPACITY];
+struct Object *gReservedObjects = NULL;
+s32 gObjectPoolCapacity = OBJECT_POOL_CAPACITY;
+struct Object *gCurrentObject = NULL;
+struct Object *gMarioObject = NULL;
+u32 gTimeStopState = 0;
+s16 gCollisionFlags = COLLISION_FLAGS_NONE;
+s32 gSurfaceNodesAllocated;
+s32 gSurfacesAllocated;
+s32 gNumStaticSurfaceNodes;
+s32 gNumStaticSurfaces;
+s32 gNumFindFloorMisses;
+TerrainData *gEnvironmentRegions;
+s32 gEnvironmentLevels[20];
+s16 gCCMEnteredSlide;
+Mat4 gCameraTransform;
+struct LakituState gLakituState;
+static struct MarioState sMarioState;
+struct MarioState *gMarioState = &sMarioState;
+static struct Area sArea;
+struct Area *gCurrentArea = &sArea;
+
+/**
+ * A two-sided stack allocator with the same contract as main_pool_alloc in memory.c.
+ */
+#define BENCH_MAIN_POOL_SIZE (64 * 1024 * 1024)
+#define BENCH_POOL_ALIGN(size) (((size) + 15) & ~15)
+
+static u8 sMainPool[BENCH_MAIN_POOL_SIZE] __attribute__((aligned(16)));
+static u8 *sPoolLeft  = sMainPool;
+static u8 *sPoolRight = sMainPool + BENCH_MAIN_POOL_SIZE;
+static u8 *sLastLeftBlock = NULL;
+
+void bench_reset_main_pool(void) {
+    sPoolLeft = sMainPool;
+    sPoolRight = sMainPool + BENCH_MAIN_POOL_SIZE;
+    sLastLeftBlock = NULL;
+}
+
+u32 bench_main_pool_used(void) {
+    return BENCH_MAIN_POOL_SIZE - (sPoolRight - sPoolLeft);
+}
+
+void *main_pool_alloc(u32 size, u32 side) {
+    size = BENCH_POOL_ALIGN(size);
+    if ((u32)(sPoolRight - sPoolLeft) < size) {
+        return NULL;
+    }
+
+    if (side == MEMORY_POOL_LEFT) {
+        sLastLeftBlock = sPoolLeft;
+        sPoolLeft += size;
+        return sLastLeftBlock;
+    }
+
+    sPoolRight -= size;
+    return sPoolRight;
+}
+
+void *main_pool_realloc(void *addr, u32 size) {
+    if (addr != sLastLeftBlock) {
+        return NULL;
+    }
+
+    sPoolLeft = sLastLeftBlock + BENCH_POOL_ALIGN(size);
+    return addr;
+}
+
+u32 main_pool_available(void) {
+    return sPoolRight - sPoolLeft;
+}
+
+void __n64Assert(char *fileName, u32 lineNum, char *message) {
+    fprintf(stderr, "%s:%u: %s\n", fileName, lineNum, message);
+    abort();
+}
+
+void *segmented_to_virtual(const void *addr) {
+    return (void *) addr;
+}
+
+/**
+ * Objects are not simulated; special objects are skipped over using the same
+ * preset table that macro_special_objects.c uses to size them.
+ */
+void spawn_special_objects(UNUSED s32 areaIndex, TerrainData **specialObjList) {
+    s32 numOfSpecialObjects = *(*specialObjList)++;
+
+    for (s32 i = 0; i < numOfSpecialObjects; i++) {
+        u8 presetID = *(*specialObjList)++;
+        *specialObjList += 3;
+
+        s32 offset = 0;
+        while (SpecialObjectPresets[offset].preset_id != presetID) {
+            offset++;
+        }
+
+        switch (SpecialObjectPresets[offset].type) {
+            case SPTYPE_YROT_NO_PARAMS:     *specialObjList += 1; break;
+            case SPTYPE_PARAMS_AND_YROT:    *specialObjList += 2; break;
+            case SPTYPE_UNKNOWN:            *specialObjList += 3; break;
+            case SPTYPE_DEF_PARAM_AND_YROT: *specialObjList += 1; break;
+            default: break;
+        }
+    }
+}
+
+void spawn_macro_objects(UNUSED s32 areaIndex, UNUSED MacroObject *macroObjList) {
+}
+
+void spawn_macro_objects_hardcoded(UNUSED s32 areaIndex, UNUSED MacroObject *macroObjList) {
+}
+
+void reset_red_coins_collected(void) {
+}
+
+void clear_dynamic_surface_references(void) {
+}
+
+f32 dist_between_objects(struct Object *obj1, struct Object *obj2) {
+    Vec3f d;
+    vec3_diff(d, &obj2->oPosVec, &obj1->oPosVec);
+    return vec3_mag(d);
+}
+
+void obj_build_transform_from_pos_and_angle(struct Object *obj, s16 posIndex, s16 angleIndex) {
+    Vec3f translate;
+    vec3f_copy(translate, &obj->rawData.asF32[posIndex]);
+    Vec3s rotation;
+    vec3i_to_vec3s(rotation, &obj->rawData.asS32[angleIndex]);
+    mtxf_rotate_zxy_and_translate(obj->transform, translate, rotation);
+}
@@ -0,0 +1,11 @@
+#include <ultra64.h>
+#include "sm64.h"
+#include "surface_terrains.h"
+#include "level_misc_macros.h"
+#include "macro_preset_names.h"
+#include "special_preset_names.h"
+
+#include "collision_bench.h"
+
+// Generated by the Makefile: includes every area's collision.inc.c and defines gBenchLevels.
+#include "level_table.inc.c"
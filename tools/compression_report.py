@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""
+Print the size, compression ratio and estimated decode time of every compressed segment in a build directory.
+
+    python3 tools/compression_report.py build/us_n64
+
+The decode estimates are rough VR4300 cycle counts from the instruction counts of each decoder's loops, assuming
+the data is in the data cache and the ROM reads keep up. For Yay0, MIO0 and LZ4 the tokens are counted, while gzip
+and RNC use an average cost per output byte. Use them to compare segments and methods with each other, not as
+timings.
+"""
+import os
+import struct
+import sys
+
+CPU_HZ = 93750000
+
+# Cycles per control word, literal, match, and matched byte.
+YAY0_COSTS = (12, 7, 16, 4)
+MIO0_COSTS = (12, 8, 18, 4)
+# Cycles per sequence, literal byte, and matched byte for short (< 8) and other offsets.
+LZ4_COSTS = (30, 1, 4, 1)
+# Cycles per output byte.
+BYTE_COSTS = {"gzip": 45, "rnc1": 35, "rnc2": 20}
+
+
+def u32(data, offset):
+    return struct.unpack(">I", data[offset:offset + 4])[0]
+
+
+def yay0_cycles(data, costs, longMatches):
+    size = u32(data, 4)
+    link = u32(data, 8)
+    chunk = u32(data, 12)
+    ctrl = 16
+    out = 0
+    bits = numBits = 0
+    cycles = 0
+    while out < size:
+        if numBits == 0:
+            bits = u32(data, ctrl)
+            ctrl += 4
+            numBits = 32
+            cycles += costs[0]
+        if bits & 0x80000000:
+            out += 1
+            chunk += 1
+            cycles += costs[1]
+        else:
+            token = (data[link] << 8) | data[link + 1]
+            link += 2
+            length = (token >> 12) + (2 if longMatches else 3)
+            if longMatches and length == 2:
+                length = data[chunk] + 18
+                chunk += 1
+            out += length
+            cycles += costs[2] + (costs[3] * length)
+        bits = (bits << 1) & 0xFFFFFFFF
+        numBits -= 1
+    return cycles
+
+
+def lz4_cycles(data):
+    size = u32(data, 4)
+    pos = 16
+    out = 0
+    cycles = 0
+    while True:
+        token = data[pos]
+        pos += 1
+        length = token >> 4
+        if length == 15:
+            while True:
+                length += data[pos]
+                pos += 1
+                if data[pos - 1] != 255:
+                    break
+        pos += length
+        out += length
+        cycles += LZ4_COSTS[0] + (LZ4_COSTS[1] * length)
+        if out >= size:
+            return cycles
+        offset = data[pos] | (data[pos + 1] << 8)
+        pos += 2
+        length = token & 0xF
+        if length == 15:
+            while True:
+                length += data[pos]
+                pos += 1
+                if data[pos - 1] != 255:
+                    break
+        length += 4
+        out += length
+        cycles += length * (LZ4_COSTS[2] if offset < 8 else LZ4_COSTS[3])
+
+
+def analyze(data):
+    """Returns the method, decompressed size and estimated decode cycles of a compressed segment."""
+    magic = data[0:4]
+    size = u32(data, 4)
+    if magic == b"Yay0":
+        return "yay0", size, yay0_cycles(data, YAY0_COSTS, True)
+    if magic == b"MIO0":
+        return "mio0", size, yay0_cycles(data, MIO0_COSTS, False)
+    if magic == b"LZ4B":
+        return "lz4", size, lz4_cycles(data)
+    if magic == b"GZIP":
+        method = "gzip"
+    elif magic == b"RNC\x01":
+        method = "rnc1"
+    elif magic == b"RNC\x02":
+        method = "rnc2"
+    else:
+        return None
+    return method, size, BYTE_COSTS[method] * size
+
+
+def main():
+    if len(sys.argv) != 2:
+        print("usage: compression_report.py <build dir>", file=sys.stderr)
+        sys.exit(1)
+
+    buildDir = sys.argv[1]
+    rows = []
+    for root, dirs, files in os.walk(buildDir):
+        for name in files:
+            if not name.endswith(".szp"):
+                continue
+            path = os.path.join(root, name)
+            with open(path, "rb") as f:
+                data = f.read()
+            result = analyze(data)
+            if result is None:
+                print("%s: unknown compression method" % path, file=sys.stderr)
+                continue
+            segment = os.path.relpath(path, buildDir)[:-len(".szp")]
+            rows.append((segment, result[0], result[1], len(data), result[2]))
+
+    rows.sort()
+    print("%-32s %-6s %10s %10s %6s %12s %8s" % ("Segment", "Method", "Size", "Packed", "Ratio", "Est. cycles", "Est. ms"))
+    for segment, method, size, packed, cycles in rows:
+        print("%-32s %-6s %10d %10d %5.1f%% %12d %8.2f" % (segment, method, size, packed,
+              100.0 * packed / max(size, 1), cycles, 1000.0 * cycles / CPU_HZ))
+
+    print()
+    totals = {}
+    for segment, method, size, packed, cycles in rows:
+        total = totals.setdefault(method, [0, 0, 0, 0])
+        total[0] += 1
+        total[1] += size
+        total[2] += packed
+        total[3] += cycles
+    for method, (count, size, packed, cycles) in sorted(totals.items()):
+        print("%-32s %-6s %10d %10d %5.1f%% %12d %8.2f" % ("Total (%d segments)" % count, method, size, packed,
+              100.0 * packed / max(size, 1), cycles, 1000.0 * cycles / CPU_HZ))
+
+
+if __name__ == "__main__":
+    main()
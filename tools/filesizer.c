@@ -46,8 +46,7 @@ size_t get_file_size(FILE* f)
 
 int main(int argc, char *argv[argc + 1])
 {
-	uint8_t bytes_to_align;
-	uint32_t* size_stored;
+	uint32_t* header;
 
 	if(argc < 4)
 	{
@@ -68,9 +67,9 @@ int main(int argc, char *argv[argc + 1])
 	
 	insize = get_file_size(fin);
 
-	// align to 16 bytes
-	bytes_to_align = 0x10 - (insize % 0x10);
-	outsize = insize + bytes_to_align + 0x10;
+	// 16 byte header, then the data aligned to 16 bytes:
+	//   "GZIP", uncompressed size, size of the data, 0 (all big-endian)
+	outsize = 0x10 + ((insize + 0xF) & ~0xF);
 
 	data = calloc(1, outsize);
 	if (!data)
@@ -79,10 +78,12 @@ int main(int argc, char *argv[argc + 1])
 		return EXIT_FAILURE;
 	}
 
-	size_t fread_result = fread(data, insize, 1, fin);
+	size_t fread_result = fread(data + 0x10, insize, 1, fin);
 
-	size_stored = data + outsize - 4;
-	*size_stored = __bswap_32(atoi(argv[3]));
+	header = data;
+	memcpy(&header[0], "GZIP", 4);
+	header[1] = __bswap_32(atoi(argv[3]));
+	header[2] = __bswap_32(insize);
 	
 	fwrite(data, outsize, 1, fout);
 
@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// LZ4 packer for the COMPRESS=lz4 option.
+//
+// Output is a 16 byte header followed by a single LZ4 block (the standard block format, with
+// little-endian match offsets), padded to a multiple of 16 bytes:
+//   0x00  "LZ4B"
+//   0x04  decompressed size (big-endian)
+//   0x08  size of the buffer the segment is decompressed in place in (big-endian)
+//   0x0C  size of this file (big-endian)
+//
+// The game reads the file into the end of the output buffer and decompresses it forwards, so the
+// buffer size is chosen here such that the decoder never writes over compressed data it has not
+// read yet, including the bytes its 8 byte copies can write past the end of a run.
+
+#define MIN_MATCH      4
+#define MAX_OFFSET     0xFFFF
+#define LAST_LITERALS  5  // The last 5 bytes are always literals
+#define MATCH_LIMIT    12 // No match may start within the last 12 bytes
+#define COPY_OVERRUN   8  // How far past the end of a run the decoder can write
+
+#define HASH_BITS      16
+#define MAX_CHAIN      512
+#define HEADER_SIZE    16
+
+static uint8_t *in;
+static int inSize;
+static int *head;
+static int *prevPos;
+
+static uint8_t *out;
+static int outPos;
+
+// How far in front of the output the compressed data has to start, to be decompressed in place.
+static long minDistance;
+
+static uint32_t hash4(const uint8_t *p) {
+    uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static void insert_pos(int pos) {
+    if (pos + MIN_MATCH <= inSize) {
+        uint32_t h = hash4(&in[pos]);
+        prevPos[pos] = head[h];
+        head[h] = pos;
+    }
+}
+
+static int find_match(int pos, int *matchOffset) {
+    int best = 0;
+    int maxLength = (inSize - LAST_LITERALS) - pos;
+    int chain = MAX_CHAIN;
+
+    if (pos + MATCH_LIMIT > inSize || maxLength < MIN_MATCH) {
+        return 0;
+    }
+
+    for (int cand = head[hash4(&in[pos])]; cand >= 0 && pos - cand <= MAX_OFFSET && chain-- > 0; cand = prevPos[cand]) {
+        if (in[cand + best] != in[pos + best]) {
+            continue;
+        }
+        int length = 0;
+        while (length < maxLength && in[cand + length] == in[pos + length]) {
+            length++;
+        }
+        if (length > best) {
+            best = length;
+            *matchOffset = pos - cand;
+            if (length == maxLength) {
+                break;
+            }
+        }
+    }
+
+    return (best >= MIN_MATCH) ? best : 0;
+}
+
+static void write_length(int length) {
+    while (length >= 255) {
+        out[outPos++] = 255;
+        length -= 255;
+    }
+    out[outPos++] = length;
+}
+
+static void check_distance(long written, long unread) {
+    if (written - unread > minDistance) {
+        minDistance = written - unread;
+    }
+}
+
+// Writes a sequence of literals from litStart to pos, followed by a match unless matchLength is 0.
+static void write_sequence(int litStart, int pos, int matchLength, int matchOffset) {
+    int litLength = pos - litStart;
+    int tokenPos = outPos++;
+    uint8_t token = ((litLength >= 15) ? 15 : litLength) << 4;
+
+    if (litLength >= 15) {
+        write_length(litLength - 15);
+    }
+    // The literal copy writes up to 8 bytes past the literals, before anything after them has been read.
+    check_distance(pos + COPY_OVERRUN, outPos + litLength);
+    memcpy(&out[outPos], &in[litStart], litLength);
+    outPos += litLength;
+
+    if (matchLength != 0) {
+        out[outPos++] = matchOffset & 0xFF;
+        out[outPos++] = matchOffset >> 8;
+        token |= (matchLength - MIN_MATCH >= 15) ? 15 : (matchLength - MIN_MATCH);
+        if (matchLength - MIN_MATCH >= 15) {
+            write_length(matchLength - MIN_MATCH - 15);
+        }
+        check_distance(pos + matchLength + COPY_OVERRUN, outPos);
+    }
+    out[tokenPos] = token;
+}
+
+static void put_be32(uint8_t *p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void encode(void) {
+    int pos = 0;
+    int litStart = 0;
+
+    head = malloc(sizeof(int) << HASH_BITS);
+    prevPos = malloc(sizeof(int) * (inSize + 1));
+    memset(head, 0xFF, sizeof(int) << HASH_BITS);
+
+    outPos = HEADER_SIZE;
+    minDistance = 0;
+
+    while (pos < inSize) {
+        int offset, length = find_match(pos, &offset);
+
+        if (length != 0) {
+            // Lazy matching: take a literal if the next position starts a longer match.
+            int nextOffset, nextLength;
+            insert_pos(pos);
+            nextLength = find_match(pos + 1, &nextOffset);
+            if (nextLength > length) {
+                pos++;
+                continue;
+            }
+            write_sequence(litStart, pos, length, offset);
+            for (int i = 1; i < length; i++) {
+                insert_pos(pos + i);
+            }
+            pos += length;
+            litStart = pos;
+        } else {
+            insert_pos(pos);
+            pos++;
+        }
+    }
+    write_sequence(litStart, inSize, 0, 0);
+
+    free(head);
+    free(prevPos);
+}
+
+int main(int argc, char **argv) {
+    FILE *fp;
+
+    if (argc < 3) {
+        fprintf(stderr, "lz4pack [infile] [outfile]\n");
+        return 1;
+    }
+
+    if ((fp = fopen(argv[1], "rb")) == NULL) {
+        fprintf(stderr, "FILE OPEN ERROR![%s]\n", argv[1]);
+        return 1;
+    }
+    fseek(fp, 0, SEEK_END);
+    inSize = ftell(fp);
+    rewind(fp);
+    in = malloc(inSize + 1);
+    if (fread(in, 1, inSize, fp) != (size_t) inSize) {
+        fprintf(stderr, "FILE READ ERROR![%s]\n", argv[1]);
+        return 1;
+    }
+    fclose(fp);
+
+    // Worst case: every byte is a literal.
+    out = calloc(HEADER_SIZE + inSize + (inSize / 255) + 32, 1);
+    encode();
+
+    uint32_t fileSize = (outPos + 15) & ~15;
+    uint32_t bufferSize = inSize + COPY_OVERRUN;
+    // The file is read in at (bufferSize - fileSize), so that has to be at least minDistance.
+    if (bufferSize < minDistance + fileSize) {
+        bufferSize = minDistance + fileSize;
+    }
+    bufferSize = (bufferSize + 15) & ~15;
+
+    memcpy(out, "LZ4B", 4);
+    put_be32(&out[4], inSize);
+    put_be32(&out[8], bufferSize);
+    put_be32(&out[12], fileSize);
+
+    if ((fp = fopen(argv[2], "wb")) == NULL) {
+        fprintf(stderr, "FILE CREATE ERROR![%s]\n", argv[2]);
+        return 1;
+    }
+    fwrite(out, 1, fileSize, fp);
+    fclose(fp);
+
+    free(in);
+    free(out);
+    return 0;
+}
@@ -1,17 +1,25 @@
 import sys, struct, subprocess
 
+# Packs the function symbols of an ELF file for the crash screen's map parser.
+#
+# addr.bin holds one entry per symbol, sorted by address so the game can binary search it:
+#   u32 address
+#   u32 offset of the name in name.bin
+# name.bin holds the names, each ending with a zero byte. Names shared by several symbols
+# (such as static functions with the same name in different files) are only stored once.
+
 class MapEntry():
-	def __init__(self, nm, addr):
+	def __init__(self, nm, addr, isGlobal):
 		self.name = nm
 		self.addr = addr
-		self.strlen = (len(nm) + 4) & (~3)
+		self.isGlobal = isGlobal
 	def __str__(self):
-		return "%s %s %d" % (self.addr, self.name, self.strlen)
+		return "%s %s" % (self.addr, self.name)
 	def __repr__(self):
-		return "%s %s %d" % (self.addr, self.name, self.strlen)
+		return "%s %s" % (self.addr, self.name)
 
 
-structDef = ">LLLL"
+structDef = ">LL"
 
 symNames = []
 
@@ -27,24 +35,31 @@ for line in symbols:
 	if len(tokens) >= 3 and len(tokens[-2]) == 1:
 		addr = int(tokens[0], 16)
 		if addr & 0x80000000 and tokens[-2].lower() == "t":
-			symNames.append(MapEntry(tokens[-1], addr))
+			symNames.append(MapEntry(tokens[-1], addr, tokens[-2] == "T"))
 
 
+# Sort by address, and keep one symbol per address, preferring global ones.
+symNames.sort(key=lambda x: (x.addr, not x.isGlobal))
+uniqueSyms = []
+for x in symNames:
+	if len(uniqueSyms) == 0 or uniqueSyms[-1].addr != x.addr:
+		uniqueSyms.append(x)
 
 f1 = open(sys.argv[2], "wb+")
 f2 = open(sys.argv[3], "wb+")
 
-symNames.sort(key=lambda x: x.addr)
-
+nameOffsets = {}
 off = 0
-for x in symNames:
-	f1.write(struct.pack(structDef, x.addr, off, len(x.name), 0))
-	f2.write(struct.pack(">%ds" % x.strlen, bytes(x.name, encoding="ascii")))
-	off += x.strlen
+for x in uniqueSyms:
+	if x.name not in nameOffsets:
+		nameOffsets[x.name] = off
+		name = bytes(x.name, encoding="ascii") + b"\0"
+		f2.write(name)
+		off += len(name)
+	f1.write(struct.pack(structDef, x.addr, nameOffsets[x.name]))
 
 
 f1.close()
 f2.close()
 
-# print('\n'.join([str(hex(x.addr)) + " " + x.name for x in symNames]))
-
+# print('\n'.join([str(hex(x.addr)) + " " + x.name for x in uniqueSyms]))
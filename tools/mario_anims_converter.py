@@ -1,9 +1,21 @@
 #!/usr/bin/env python3
+import argparse
 import re
 import os
 import traceback
 import sys
 
+# Each animation is stored as a PackedDmaHeader, the Animation structs and index table as they are, and then the
+# values packed into blocks (see unpack_s16_values in src/boot/memory.c). Every block starts with a big-endian u16:
+#   bits 15-7: number of values - 1
+#   bits 6-2:  0 if the values follow as they are, otherwise the size in bits of each residual
+#   bits 1-0:  how many low bits were dropped from the values (rotations only)
+# A block of residuals has its first value, followed by the difference between each next value and the one
+# predicted from the two before it, packed into as many bits as the largest one needs and padded to a byte.
+# The blocks are split wherever a part of the animation starts or ends, so that each one covers a smooth curve.
+BLOCK_MAX_VALUES = 512
+BLOCK_HEADER_SIZE = 2
+
 num_headers = 0
 items = []
 len_mapping = {}
@@ -73,6 +85,101 @@ def parse_file(filename, lines):
             name = lines[lineindex][len("s16 "):-6]
             lineindex = parse_array(filename, lines, lineindex, name, is_indices)
 
+def wrap_s16(value):
+    return ((value + 0x8000) & 0xFFFF) - 0x8000
+
+def bits_needed(value):
+    bits = 1
+    while not (-(1 << (bits - 1)) <= value < (1 << (bits - 1))):
+        bits += 1
+    return bits
+
+def pack_block_header(count, width, shift):
+    header = ((count - 1) << 7) | (width << 2) | shift
+    return [header >> 8, header & 0xFF]
+
+def pack_s16(value):
+    return [(value >> 8) & 0xFF, value & 0xFF]
+
+def pack_residuals(values, shift):
+    """Returns the residual block for a run of values, or None if storing them as they are is no larger."""
+    if len(values) == 1:
+        return None
+    if shift != 0:
+        values = [wrap_s16((v + (1 << (shift - 1))) >> shift) for v in values]
+    prev = prev2 = values[0]
+    residuals = []
+    for value in values[1:]:
+        residuals.append(wrap_s16(value - wrap_s16(2 * prev - prev2)))
+        prev2, prev = prev, value
+    width = max(bits_needed(r) for r in residuals)
+    if width >= 16:
+        return None
+
+    out = pack_block_header(len(values), width, shift) + pack_s16(values[0])
+    bitBuf = numBits = 0
+    for residual in residuals:
+        bitBuf = (bitBuf << width) | (residual & ((1 << width) - 1))
+        numBits += width
+        while numBits >= 8:
+            numBits -= 8
+            out.append((bitBuf >> numBits) & 0xFF)
+    if numBits != 0:
+        out.append((bitBuf << (8 - numBits)) & 0xFF)
+    return out
+
+def pack_values(values, index_tables, rotation_shift):
+    """Pack a values array, given all the index tables that use it."""
+    values = [wrap_s16(int(v, 0)) for v in values]
+    breaks = {0, len(values)}
+    shifts = [rotation_shift] * len(values)
+    for indices in index_tables:
+        indices = [int(v, 0) for v in indices]
+        for channel in range(len(indices) // 2):
+            length, offset = indices[channel * 2], indices[channel * 2 + 1]
+            breaks.update((offset, offset + length))
+            # The first three are the translation, which is never quantized.
+            if channel < 3:
+                for i in range(offset, offset + length):
+                    shifts[i] = 0
+    breaks = sorted(b for b in breaks if b <= len(values))
+    runs = []
+    for start, end in zip(breaks, breaks[1:]):
+        for i in range(start, end, BLOCK_MAX_VALUES):
+            runs.append((i, min(i + BLOCK_MAX_VALUES, end)))
+
+    out = []
+    raw = []
+
+    def flush_raw():
+        out.extend(pack_block_header(len(raw), 0, 0))
+        for value in raw:
+            out.extend(pack_s16(value))
+        raw.clear()
+
+    for start, end in runs:
+        block = pack_residuals(values[start:end], min(shifts[start:end]))
+        # Compare with adding the values to the block before, if that's one of values as they are.
+        rawSize = 2 * (end - start)
+        if not raw or len(raw) + (end - start) > BLOCK_MAX_VALUES:
+            rawSize += BLOCK_HEADER_SIZE
+        if block is not None and len(block) < rawSize:
+            if raw:
+                flush_raw()
+            out.extend(block)
+        else:
+            if raw and len(raw) + (end - start) > BLOCK_MAX_VALUES:
+                flush_raw()
+            raw.extend(values[start:end])
+    if raw:
+        flush_raw()
+    return out
+
+parser = argparse.ArgumentParser(description="Convert Mario's animations in assets/anims to C")
+parser.add_argument("--rotation-shift", type=int, default=0, choices=range(4),
+                    help="how many low bits of each rotation to drop, to pack them smaller (0 is lossless)")
+args = parser.parse_args()
+
 try:
     files = os.listdir("assets/anims")
     files.sort()
@@ -95,6 +202,8 @@ try:
 
     structdef = ["u32 numEntries;", "const struct Animation *addrPlaceholder;", "struct OffsetSizePair entries[" + str(num_headers) + "];"]
     structobj = [str(num_headers) + ",", "NULL,","{"]
+    arrays = {name: obj[1] for type, name, obj in items if type == "array"}
+    index_tables = {}
 
     for item in items:
         type, name, obj = item
@@ -104,10 +213,10 @@ try:
                 raise SyntaxError("Error: Animation struct must be written before indices array for " + name)
             if order_mapping[values] < order_mapping[indices]:
                 raise SyntaxError("Error: values array must be written after indices array for " + name)
-            values_num_values = len_mapping[values]
-            offset_to_struct = "offsetof(struct MarioAnimsObj, " + name + ")"
+            offset_to_header = "offsetof(struct MarioAnimsObj, " + name + "_header)"
             offset_to_end = "offsetof(struct MarioAnimsObj, " + values + ") + sizeof(gMarioAnims." + values + ")"
-            structobj.append("{" + offset_to_struct + ", " + offset_to_end + " - " + offset_to_struct + "},")
+            structobj.append("{" + offset_to_header + ", " + offset_to_end + " - " + offset_to_header + "},")
+            index_tables.setdefault(values, []).append(arrays[indices])
     structobj.append("},")
 
     for item in items:
@@ -116,8 +225,14 @@ try:
             v1, v2, v3, v4, v5, values, indices = obj
             indices_len = len_mapping[indices] // 6 - 1
             values_num_values = len_mapping[values]
+            if values_num_values > 0xFFFF:
+                raise SyntaxError("Error: too many values for " + name)
             offset_to_struct = "offsetof(struct MarioAnimsObj, " + name + ")"
-            offset_to_end = "offsetof(struct MarioAnimsObj, " + values + ") + sizeof(gMarioAnims." + values + ")"
+            offset_to_values = "offsetof(struct MarioAnimsObj, " + values + ")"
+            # The values take twice as much space once they're unpacked.
+            offset_to_end = offset_to_values + " + " + str(values_num_values * 2)
+            structdef.append("struct PackedDmaHeader " + name + "_header;")
+            structobj.append("{" + offset_to_values + " - " + offset_to_struct + ", " + str(values_num_values) + "},")
             structdef.append("struct Animation " + name + ";")
             structobj.append("{" + ", ".join([
                 str(v1),
@@ -132,9 +247,13 @@ try:
             ]) + "},")
         else:
             is_indices, arr = obj
-            type = "u16" if is_indices else "s16"
-            structdef.append("{} {}[{}];".format(type, name, len(arr)))
-            structobj.append("{" + ",".join(arr) + "},")
+            if is_indices:
+                structdef.append("u16 {}[{}];".format(name, len(arr)))
+                structobj.append("{" + ",".join(arr) + "},")
+            else:
+                packed = pack_values(arr, index_tables.get(name, []), args.rotation_shift)
+                structdef.append("u8 {}[{}];".format(name, len(packed)))
+                structobj.append("{" + ",".join(str(b) for b in packed) + "},")
 
     print("#include \"game/memory.h\"")
     print("#include <stddef.h>")